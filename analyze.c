@@ -0,0 +1,611 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Steganalysis mode (--analyze), measures how detectable LSB
+              embedding in a cover or stego image is.
+
+              Per channel it computes:
+              1. Pairs of values chi-square attack (Westfeld / Pfitzmann).
+                 LSB replacement equalises the counts of 2k and 2k+1, so a
+                 p-value near 1 means random LSBs. The p-value is also given
+                 over growing leading parts of the pixel data, which shows
+                 how far a sequential embedding reaches.
+              2. RS analysis (Fridrich), estimate of the fraction of pixels
+                 whose LSB carries message bits, from Regular / Singular
+                 groups of 4 pixels under flipping masks.
+
+              Pixel data is mmapped through the format backends and split
+              in bands of rows (tiles) which a pool of threads (-t) works
+              on. Every row is read once: pixels are counted into split
+              histograms (consecutive pixels do not wait on the same
+              counter) while they are split into planes of RS groups,
+              which are then counted 8 groups at a time with SSE2. Histogram
+              updates stay scalar, SSE2 has no scatter store, the split
+              counters hide the store to load latency instead.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "analyze.h"
+#include "format.h"
+#include "types.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Work shared by analysis threads */
+typedef struct _AnalyzeJob
+{
+    const unsigned char *pixels;
+    uint stride;             //bytes per pixel row including padding
+    uint width;
+    uint channels;
+    uint rows_per_tile;
+    uint height;
+    uint tile_count;
+    uint next_tile;        //next tile to take, under lock
+    TileStats *tiles;
+    int failed;            //a worker could not allocate its buffers, under lock
+    pthread_mutex_t lock;
+
+} AnalyzeJob;
+
+//to measure smoothness of a group of 4 pixels
+static inline int group_variation(int a, int b, int c, int d)
+{
+    return abs(b - a) + abs(c - b) + abs(d - c);
+}
+
+//to flip LSB with shifted pairs (-1,0) (1,2) ... used by mask -M
+static inline int flip_negative(int v)
+{
+    return ((v + 1) ^ 1) - 1;
+}
+
+#ifdef __SSE2__
+//to get |x - y| of 8 shorts
+static inline __m128i abs_diff16(__m128i x, __m128i y)
+{
+    return _mm_max_epi16(_mm_sub_epi16(x, y), _mm_sub_epi16(y, x));
+}
+
+//to get flip_negative() of 8 shorts
+static inline __m128i flip_negative16(__m128i v, __m128i one)
+{
+    return _mm_sub_epi16(_mm_xor_si128(_mm_add_epi16(v, one), one), one);
+}
+
+//to add 8 short counters into 32 bit count
+static inline unsigned long sum16(__m128i v)
+{
+    __m128i s = _mm_madd_epi16(v, _mm_set1_epi16(1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+    return (uint)_mm_cvtsi128_si32(s);
+}
+#endif
+
+/*
+ * Count Regular / Singular groups
+ * Input: planes g[0..3] with pixel k of n groups in g[k]
+ * Output: count[8] in TileStats rs order is incremented
+ */
+static void rs_count_groups(const short *g0, const short *g1, const short *g2, const short *g3, uint n, unsigned long *count)
+{
+    uint m = 0;
+#ifdef __SSE2__
+    const __m128i one = _mm_set1_epi16(1);
+    while(m + 8 <= n)
+    {
+        __m128i acc[8];
+        for(int i = 0; i < 8; i++)
+        {
+            acc[i] = _mm_setzero_si128();
+        }
+
+        //short counters take at most 8192 steps of 8 groups before flush
+        uint end = n - ((n - m) & 7);
+        if(end - m > 8192 * 8)
+        {
+            end = m + 8192 * 8;
+        }
+        for(; m < end; m += 8)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i *)(g0 + m));
+            __m128i b = _mm_loadu_si128((const __m128i *)(g1 + m));
+            __m128i c = _mm_loadu_si128((const __m128i *)(g2 + m));
+            __m128i d = _mm_loadu_si128((const __m128i *)(g3 + m));
+            __m128i a1 = _mm_xor_si128(a, one), b1 = _mm_xor_si128(b, one);
+            __m128i c1 = _mm_xor_si128(c, one), d1 = _mm_xor_si128(d, one);
+            __m128i bn = flip_negative16(b, one), cn = flip_negative16(c, one);
+            __m128i bn1 = flip_negative16(b1, one), cn1 = flip_negative16(c1, one);
+            __m128i bc = abs_diff16(b, c), bc1 = abs_diff16(b1, c1);
+
+            __m128i f = _mm_add_epi16(_mm_add_epi16(abs_diff16(a, b), bc), abs_diff16(c, d));
+            __m128i fm = _mm_add_epi16(_mm_add_epi16(abs_diff16(a, b1), bc1), abs_diff16(c1, d));
+            __m128i fn = _mm_add_epi16(_mm_add_epi16(abs_diff16(a, bn), abs_diff16(bn, cn)), abs_diff16(cn, d));
+            acc[0] = _mm_sub_epi16(acc[0], _mm_cmpgt_epi16(fm, f));
+            acc[1] = _mm_sub_epi16(acc[1], _mm_cmpgt_epi16(f, fm));
+            acc[2] = _mm_sub_epi16(acc[2], _mm_cmpgt_epi16(fn, f));
+            acc[3] = _mm_sub_epi16(acc[3], _mm_cmpgt_epi16(f, fn));
+
+            f = _mm_add_epi16(_mm_add_epi16(abs_diff16(a1, b1), bc1), abs_diff16(c1, d1));
+            fm = _mm_add_epi16(_mm_add_epi16(abs_diff16(a1, b), bc), abs_diff16(c, d1));
+            fn = _mm_add_epi16(_mm_add_epi16(abs_diff16(a1, bn1), abs_diff16(bn1, cn1)), abs_diff16(cn1, d1));
+            acc[4] = _mm_sub_epi16(acc[4], _mm_cmpgt_epi16(fm, f));
+            acc[5] = _mm_sub_epi16(acc[5], _mm_cmpgt_epi16(f, fm));
+            acc[6] = _mm_sub_epi16(acc[6], _mm_cmpgt_epi16(fn, f));
+            acc[7] = _mm_sub_epi16(acc[7], _mm_cmpgt_epi16(f, fn));
+        }
+        for(int i = 0; i < 8; i++)
+        {
+            count[i] += sum16(acc[i]);
+        }
+    }
+#endif
+    for(; m < n; m++)
+    {
+        int a = g0[m], b = g1[m], c = g2[m], d = g3[m];
+
+        //mask M = [0 1 1 0] and -M on the image
+        int f = group_variation(a, b, c, d);
+        int fm = group_variation(a, b ^ 1, c ^ 1, d);
+        int fn = group_variation(a, flip_negative(b), flip_negative(c), d);
+        count[0] += fm > f;
+        count[1] += fm < f;
+        count[2] += fn > f;
+        count[3] += fn < f;
+
+        //same on the image with all LSBs flipped
+        f = group_variation(a ^ 1, b ^ 1, c ^ 1, d ^ 1);
+        fm = group_variation(a ^ 1, b, c, d ^ 1);
+        fn = group_variation(a ^ 1, flip_negative(b ^ 1), flip_negative(c ^ 1), d ^ 1);
+        count[4] += fm > f;
+        count[5] += fm < f;
+        count[6] += fn > f;
+        count[7] += fn < f;
+    }
+}
+
+/*
+ * Scan one pixel row
+ * Description: pixels are counted into split histograms while they are
+ * split into planes of groups of 4 pixels, then RS groups are counted.
+ * A constant channel count lets the compiler unroll the loops.
+ */
+static inline void scan_pixels(const unsigned char *row, uint width, uint channels, uint (*split)[ANALYZE_MAX_CHANNELS][256], short *planes, unsigned long (*rs)[8])
+{
+    uint n = width / 4;   //groups of 4 pixels per channel
+    short *g0 = planes, *g1 = planes + n, *g2 = planes + 2 * n, *g3 = planes + 3 * n;
+    for(uint c = 0; c < channels; c++)
+    {
+        const unsigned char *p = row + c;
+        for(uint m = 0; m < n; m++, p += 4 * channels)
+        {
+            uint v0 = p[0], v1 = p[channels], v2 = p[2 * channels], v3 = p[3 * channels];
+            split[0][c][v0]++;
+            split[1][c][v1]++;
+            split[2][c][v2]++;
+            split[3][c][v3]++;
+            g0[m] = v0;
+            g1[m] = v1;
+            g2[m] = v2;
+            g3[m] = v3;
+        }
+        rs_count_groups(g0, g1, g2, g3, n, rs[c]);
+    }
+
+    //pixels after the last full group
+    for(uint x = n * 4; x < width; x++)
+    {
+        for(uint c = 0; c < channels; c++)
+        {
+            split[0][c][row[x * channels + c]]++;
+        }
+    }
+}
+
+//to scan one row with channel count known at compile time for common formats
+static void scan_row(const unsigned char *row, uint width, uint channels, uint (*split)[ANALYZE_MAX_CHANNELS][256], short *planes, unsigned long (*rs)[8])
+{
+    if(channels == 1)
+    {
+        scan_pixels(row, width, 1, split, planes, rs);
+    }
+    else if(channels == 3)
+    {
+        scan_pixels(row, width, 3, split, planes, rs);
+    }
+    else if(channels == 4)
+    {
+        scan_pixels(row, width, 4, split, planes, rs);
+    }
+    else
+    {
+        scan_pixels(row, width, channels, split, planes, rs);
+    }
+}
+
+//thread function, takes tiles until all are done
+static void *analyze_worker(void *arg)
+{
+    AnalyzeJob *job = arg;
+    uint (*split)[ANALYZE_MAX_CHANNELS][256] = malloc(sizeof(uint) * ANALYZE_SPLIT_COUNTERS * ANALYZE_MAX_CHANNELS * 256);
+    short *planes = malloc(sizeof(short) * (job->width + 4));
+    if(split == NULL || planes == NULL)
+    {
+        //tiles left to this worker would stay zero, the analysis must fail
+        pthread_mutex_lock(&job->lock);
+        job->failed = 1;
+        pthread_mutex_unlock(&job->lock);
+        free(split);
+        free(planes);
+        return NULL;
+    }
+    while(1)
+    {
+        pthread_mutex_lock(&job->lock);
+        uint tile = job->next_tile++;
+        pthread_mutex_unlock(&job->lock);
+        if(tile >= job->tile_count)
+        {
+            break;
+        }
+
+        TileStats *stats = &job->tiles[tile];
+        uint first = tile * job->rows_per_tile;
+        uint last = first + job->rows_per_tile;
+        if(last > job->height)
+        {
+            last = job->height;
+        }
+        memset(split, 0, sizeof(uint) * ANALYZE_SPLIT_COUNTERS * ANALYZE_MAX_CHANNELS * 256);
+        for(uint y = first; y < last; y++)
+        {
+            const unsigned char *row = job->pixels + (unsigned long)y * job->stride;
+            scan_row(row, job->width, job->channels, split, planes, stats->rs);
+        }
+
+        //to merge split counters into tile histogram
+        for(uint c = 0; c < job->channels; c++)
+        {
+            for(int v = 0; v < 256; v++)
+            {
+                stats->hist[c][v] = split[0][c][v] + split[1][c][v] + split[2][c][v] + split[3][c][v];
+            }
+        }
+    }
+    free(split);
+    free(planes);
+    return NULL;
+}
+
+//to compute regularized upper incomplete gamma Q(a, x)
+static double gamma_q(double a, double x)
+{
+    if(x <= 0)
+    {
+        return 1.0;
+    }
+    double log_front = a * log(x) - x - lgamma(a);
+    if(x < a + 1)
+    {
+        //series for P(a, x)
+        double term = 1.0 / a, sum = term;
+        for(int n = 1; n < 1000 && fabs(term) > fabs(sum) * 1e-15; n++)
+        {
+            term *= x / (a + n);
+            sum += term;
+        }
+        return 1.0 - sum * exp(log_front);
+    }
+
+    //continued fraction for Q(a, x), modified Lentz
+    double b = x + 1 - a, c = 1e300, d = 1 / b, h = d;
+    for(int n = 1; n < 1000; n++)
+    {
+        double an = -n * (n - a);
+        b += 2;
+        d = an * d + b;
+        d = (fabs(d) < 1e-300) ? 1e-300 : d;
+        c = b + an / c;
+        c = (fabs(c) < 1e-300) ? 1e-300 : c;
+        d = 1 / d;
+        double delta = d * c;
+        h *= delta;
+        if(fabs(delta - 1) < 1e-15)
+        {
+            break;
+        }
+    }
+    return exp(log_front) * h;
+}
+
+/*
+ * Pairs of values chi-square
+ * Input: histogram of 256 values
+ * Output: chi-square statistic and degrees of freedom
+ * Return Value: probability that pairs are equalised by embedding
+ */
+double chi_square_pov(const unsigned long *hist, double *chi2, int *df)
+{
+    int pairs = 0;
+    *chi2 = 0;
+    for(int k = 0; k < 128; k++)
+    {
+        unsigned long sum = hist[2 * k] + hist[2 * k + 1];
+        if(sum < ANALYZE_MIN_PAIR_COUNT)
+        {
+            continue;
+        }
+        double expected = sum / 2.0;
+        double diff = hist[2 * k] - expected;
+        *chi2 += diff * diff / expected;
+        pairs++;
+    }
+    *df = pairs - 1;
+    if(*df < 1)
+    {
+        return 0;   //not enough data
+    }
+    return gamma_q(*df / 2.0, *chi2 / 2.0);
+}
+
+/*
+ * RS analysis estimate
+ * Input: R_M, S_M, R_-M, S_-M of image and of LSB flipped image
+ * Return Value: estimated fraction of pixels carrying message bits, 0 to 1
+ */
+double rs_estimate(const unsigned long *rs)
+{
+    double d0 = (double)rs[0] - rs[1];
+    double n0 = (double)rs[2] - rs[3];
+    double d1 = (double)rs[4] - rs[5];
+    double n1 = (double)rs[6] - rs[7];
+    if(fabs(d0) < ANALYZE_RS_SATURATED * (rs[0] + rs[1]) && fabs(d1) < ANALYZE_RS_SATURATED * (rs[4] + rs[5]))
+    {
+        return 1;   //R = S on image and flipped image, every LSB replaced, quadratic is degenerate
+    }
+    double a = 2 * (d1 + d0);
+    double b = n0 - n1 - d1 - 3 * d0;
+    double c = d0 - n0;
+    double z;
+    if(fabs(a) < 1e-9)
+    {
+        if(fabs(b) < 1e-9)
+        {
+            return 0;
+        }
+        z = -c / b;
+    }
+    else
+    {
+        double disc = b * b - 4 * a * c;
+        if(disc < 0)
+        {
+            return 0;
+        }
+        double z1 = (-b + sqrt(disc)) / (2 * a);
+        double z2 = (-b - sqrt(disc)) / (2 * a);
+        z = (fabs(z1) < fabs(z2)) ? z1 : z2;   //root with smaller absolute value
+    }
+    double p = z / (z - 0.5);
+    if(p < 0)
+    {
+        p = 0;
+    }
+    else if(p > 1)
+    {
+        p = 1;
+    }
+    return p;
+}
+
+//to name channel c as stored in pixel data
+static const char *channel_name(const ImageInfo *image, uint c)
+{
+    static const char *bgra[] = {"Blue", "Green", "Red", "Alpha"};
+    static const char *rgb[] = {"Red", "Green", "Blue"};
+    if(image->channels == 1)
+    {
+        return "Gray";
+    }
+    if(!strcmp(image->format->name, "PPM/PGM"))
+    {
+        return rgb[c];
+    }
+    return bgra[c];
+}
+
+/*
+ * Analyze image for LSB embedding
+ * Input: image file name, options (-t threads)
+ * Description: prints chi-square and RS statistics per channel
+ * and chi-square p-value over leading parts of pixel data.
+ */
+Status do_analyze(const char *image_fname, const StegoOptions *opts)
+{
+    FILE *fptr = fopen(image_fname, "r");
+    if(fptr == NULL)
+    {
+        perror("fopen");
+        fprintf(stderr, "ERROR: Unable to open file %s\n", image_fname);
+        return e_failure;
+    }
+    ImageInfo image;
+    if(read_image_info(fptr, &image) == e_failure)
+    {
+        fclose(fptr);
+        return e_failure;
+    }
+    if(image.channels == 0 || image.channels > ANALYZE_MAX_CHANNELS || image.height == 0)
+    {
+        printf("ERROR: %u bytes per pixel is not supported for analysis\n", image.channels);
+        fclose(fptr);
+        return e_failure;
+    }
+    //rows are scanned as width * channels bytes every stride bytes, all of it must be pixel data
+    uint stride = image.pixel_size / image.height;
+    if((unsigned long long)image.width * image.channels > stride || (unsigned long long)stride * image.height > image.pixel_size)
+    {
+        printf("ERROR: %s pixel rows of %u x %u bytes do not fit in %u pixel bytes\n", image.format->name, image.width, image.channels, image.pixel_size);
+        fclose(fptr);
+        return e_failure;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    size_t map_size = image.pixel_offset + image.pixel_size;
+    unsigned char *map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fileno(fptr), 0);
+    fclose(fptr);   //mapping stays valid
+    if(map == MAP_FAILED)
+    {
+        perror("mmap");
+        return e_failure;
+    }
+    madvise(map, map_size, MADV_SEQUENTIAL);
+
+    AnalyzeJob job;
+    job.pixels = map + image.pixel_offset;
+    job.stride = stride;
+    job.width = image.width;
+    job.channels = image.channels;
+    job.height = image.height;
+    job.tile_count = (image.height < ANALYZE_MAX_TILES) ? image.height : ANALYZE_MAX_TILES;
+    job.rows_per_tile = (image.height + job.tile_count - 1) / job.tile_count;
+    job.tile_count = (image.height + job.rows_per_tile - 1) / job.rows_per_tile;
+    job.next_tile = 0;
+    job.failed = 0;
+    job.tiles = calloc(job.tile_count, sizeof(TileStats));
+    pthread_mutex_init(&job.lock, NULL);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint threads = opts->threads ? opts->threads : ((cpus > 0) ? cpus : 1);
+    if(threads > job.tile_count)
+    {
+        threads = job.tile_count;
+    }
+    pthread_t *workers = calloc(threads, sizeof(pthread_t));
+    if(job.tiles == NULL || workers == NULL)
+    {
+        printf("ERROR: Unable to allocate memory for analysis\n");
+        free(job.tiles);
+        free(workers);
+        munmap(map, map_size);
+        return e_failure;
+    }
+
+    printf("INFO: ## Analysis Procedure Started ##\n");
+    printf("INFO: %s image %ux%u, %u channels, %u pixel bytes, %u threads\n", image.format->name, image.width, image.height, image.channels, image.pixel_size, threads);
+    uint started = 0;
+    for(uint i = 0; i < threads; i++)
+    {
+        if(pthread_create(&workers[i], NULL, analyze_worker, &job) == 0)
+        {
+            started++;
+        }
+    }
+    if(started == 0)
+    {
+        analyze_worker(&job);   //no threads, work in this thread
+    }
+    for(uint i = 0; i < started; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    if(job.failed)
+    {
+        printf("ERROR: Unable to allocate memory for analysis\n");
+        pthread_mutex_destroy(&job.lock);
+        free(job.tiles);
+        free(workers);
+        munmap(map, map_size);
+        return e_failure;
+    }
+
+    //to sum tiles in pixel data order, chi-square of every 10% of leading data
+    TileStats total;
+    memset(&total, 0, sizeof(total));
+    uint decile = 0;
+    uint embedded_percent = 0;   //leading part where every checkpoint looks embedded
+    int embedded = 1;
+    for(uint t = 0; t < job.tile_count; t++)
+    {
+        for(uint c = 0; c < image.channels; c++)
+        {
+            for(int v = 0; v < 256; v++)
+            {
+                total.hist[c][v] += job.tiles[t].hist[c][v];
+            }
+            for(int i = 0; i < 8; i++)
+            {
+                total.rs[c][i] += job.tiles[t].rs[c][i];
+            }
+        }
+        uint percent = (t + 1) * 100 / job.tile_count;
+        if(percent / 10 == decile)
+        {
+            continue;
+        }
+        decile = percent / 10;
+        printf("INFO: Leading %3u%% of pixel data, chi-square p-value", percent);
+        double min_p = 1;
+        for(uint c = 0; c < image.channels; c++)
+        {
+            double chi2;
+            int df;
+            double p = chi_square_pov(total.hist[c], &chi2, &df);
+            printf(" %s %.4f", channel_name(&image, c), p);
+            min_p = (p < min_p) ? p : min_p;
+        }
+        printf("\n");
+        if(embedded && min_p > ANALYZE_P_THRESHOLD)
+        {
+            embedded_percent = percent;
+        }
+        else
+        {
+            embedded = 0;
+        }
+    }
+
+    double rate_sum = 0;
+    for(uint c = 0; c < image.channels; c++)
+    {
+        double chi2;
+        int df;
+        double p = chi_square_pov(total.hist[c], &chi2, &df);
+        double rate = rs_estimate(total.rs[c]);
+        rate_sum += rate;
+        printf("INFO: Channel %-5s chi-square %.1f (%d df), p-value %.4f, RS embedding rate %.1f%%\n", channel_name(&image, c), chi2, df, p, rate * 100);
+    }
+    double rate = rate_sum / image.channels;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if(embedded_percent > 0)
+    {
+        printf("INFO: Sequential LSB embedding detected in about the first %u%% of pixel data\n", embedded_percent);
+    }
+    else
+    {
+        printf("INFO: No sequential LSB embedding detected by chi-square\n");
+    }
+    printf("INFO: RS analysis estimates about %lu hidden bytes (%.1f%% of pixel LSBs)\n", (unsigned long)(rate * image.pixel_size / 8), rate * 100);
+    printf("INFO: Analysis took %.1f ms\n", (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6);
+    printf("INFO: ## Analysis Done ##\n");
+
+    pthread_mutex_destroy(&job.lock);
+    free(job.tiles);
+    free(workers);
+    munmap(map, map_size);
+    return e_success;
+}
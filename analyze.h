@@ -0,0 +1,46 @@
+#ifndef ANALYZE_H
+#define ANALYZE_H
+
+#include "types.h" // Contains user defined types
+
+/* Channels per pixel handled by analysis (BGRA) */
+#define ANALYZE_MAX_CHANNELS 4
+
+/* Pixel rows are split into at most this many tiles, also the prefix curve resolution */
+#define ANALYZE_MAX_TILES 100
+
+/* Histogram copies per tile, consecutive pixels update different copies */
+#define ANALYZE_SPLIT_COUNTERS 4
+
+/* Value pairs with fewer samples are left out of chi-square */
+#define ANALYZE_MIN_PAIR_COUNT 8
+
+/* R_M and S_M closer than this fraction means LSBs are fully replaced */
+#define ANALYZE_RS_SATURATED 0.01
+
+/* Chi-square p-value above which pixel data is reported as embedded */
+#define ANALYZE_P_THRESHOLD 0.95
+
+/*
+ * Statistics of one tile (band of pixel rows), per channel.
+ * rs[] counts Regular / Singular groups for mask M and -M,
+ * on the image and on the image with all LSBs flipped:
+ * R_M, S_M, R_-M, S_-M, R'_M, S'_M, R'_-M, S'_-M
+ */
+typedef struct _TileStats
+{
+    unsigned long hist[ANALYZE_MAX_CHANNELS][256];
+    unsigned long rs[ANALYZE_MAX_CHANNELS][8];
+
+} TileStats;
+
+/* Chi-square p-value of pairs of values histogram, near 1 when LSBs are random */
+double chi_square_pov(const unsigned long *hist, double *chi2, int *df);
+
+/* RS analysis estimate of fraction of pixels carrying message bits */
+double rs_estimate(const unsigned long *rs);
+
+/* Report how detectable LSB embedding in image is */
+Status do_analyze(const char *image_fname, const StegoOptions *opts);
+
+#endif
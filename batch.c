@@ -0,0 +1,353 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Batch mode, runs a list of encode / decode jobs with image
+              reads and stego writes queued on the asynchronous I/O engine.
+
+              Up to -n image buffers are in use. While reads of the next
+              images and writes of finished stego images are in flight,
+              images which are already loaded are encoded from memory
+              (fmemopen / open_memstream), reusing the normal encoding
+              and decoding functions.
+
+              Job list format, one job per line, same as command line:
+                    -e <image> <secret> [stego image]
+                    -d <stego image> [output file]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "batch.h"
+#include "ioengine.h"
+#include "encode.h"
+#include "decode.h"
+#include "types.h"
+
+//to split job line into argv style args, args[0] is unused like program name
+static Status batch_parse_line(BatchSlot *slot)
+{
+    slot->argc = 1;
+    slot->args[0] = "stego";
+    char *token = strtok(slot->line, " \t\r\n");
+    while(token != NULL && slot->argc < 5)
+    {
+        slot->args[slot->argc++] = token;
+        token = strtok(NULL, " \t\r\n");
+    }
+    for(int i = slot->argc; i < 6; i++)
+    {
+        slot->args[i] = NULL;
+    }
+    if(token != NULL || slot->argc < 3)
+    {
+        return e_failure;
+    }
+    return e_success;
+}
+
+//to read next job line into slot and queue read of its image
+static Status batch_start_job(IoEngine *io, BatchSlot *slot, int index)
+{
+    //only -e / -d jobs, other modes are not valid in a job list
+    if(batch_parse_line(slot) == e_failure || (check_operation_type(slot->args) != e_encode && check_operation_type(slot->args) != e_decode))
+    {
+        printf("ERROR: Invalid job line\n");
+        return e_failure;
+    }
+
+    slot->in_fd = open(slot->args[2], O_RDONLY);
+    if(slot->in_fd < 0)
+    {
+        perror("open");
+        fprintf(stderr, "ERROR: Unable to open file %s\n", slot->args[2]);
+        return e_failure;
+    }
+    struct stat st;
+    if(fstat(slot->in_fd, &st) < 0 || st.st_size == 0 || (slot->in_buf = malloc(st.st_size)) == NULL)
+    {
+        printf("ERROR: Unable to load %s\n", slot->args[2]);
+        close(slot->in_fd);
+        return e_failure;
+    }
+    slot->in_size = st.st_size;
+    slot->in_done = 0;
+    if(io_submit_read(io, slot->in_fd, slot->in_buf, slot->in_size, 0, index) == e_failure)
+    {
+        free(slot->in_buf);
+        slot->in_buf = NULL;
+        close(slot->in_fd);
+        return e_failure;
+    }
+    slot->state = e_slot_reading;
+    return e_success;
+}
+
+//to encode loaded image into memory stream, stego image is written later
+static Status batch_encode(BatchSlot *slot, const StegoOptions *opts)
+{
+    EncodeInfo encInfo;
+    memset(&encInfo, 0, sizeof(encInfo));
+    if(read_and_validate_encode_args(slot->args, &encInfo, slot->argc) == e_failure)
+    {
+        return e_failure;
+    }
+    if(set_encode_options(&encInfo, opts) == e_failure)
+    {
+        return e_failure;
+    }
+
+    encInfo.fptr_src_image = fmemopen(slot->in_buf, slot->in_size, "r");
+    encInfo.fptr_secret = fopen(encInfo.secret_fname, "r");
+    encInfo.fptr_stego_image = open_memstream(&slot->out_buf, &slot->out_size);
+    if(encInfo.fptr_secret == NULL)
+    {
+        perror("fopen");
+        fprintf(stderr, "ERROR: Unable to open file %s\n", encInfo.secret_fname);
+    }
+
+    Status status = e_failure;
+    if(encInfo.fptr_src_image != NULL && encInfo.fptr_secret != NULL && encInfo.fptr_stego_image != NULL)
+    {
+        status = encode_open_files(&encInfo);
+    }
+
+    //streams are closed by encoding only on success
+    if(encInfo.fptr_src_image != NULL)
+    {
+        fclose(encInfo.fptr_src_image);
+    }
+    if(encInfo.fptr_stego_image != NULL)
+    {
+        fclose(encInfo.fptr_stego_image);
+    }
+    if(encInfo.fptr_secret != NULL)
+    {
+        fclose(encInfo.fptr_secret);
+    }
+    if(status == e_failure)
+    {
+        free(slot->out_buf);
+        slot->out_buf = NULL;
+        return e_failure;
+    }
+
+    slot->out_fd = open(encInfo.stego_image_fname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(slot->out_fd < 0)
+    {
+        perror("open");
+        fprintf(stderr, "ERROR: Unable to open file %s\n", encInfo.stego_image_fname);
+        free(slot->out_buf);
+        slot->out_buf = NULL;
+        return e_failure;
+    }
+    slot->out_done = 0;
+    return e_success;
+}
+
+//to decode loaded stego image, output secret file is small and written directly
+static Status batch_decode(BatchSlot *slot, const StegoOptions *opts)
+{
+    DecodeInfo decInfo;
+    memset(&decInfo, 0, sizeof(decInfo));
+    if(read_and_validate_decode_args(slot->args, &decInfo, slot->argc) == e_failure)
+    {
+        return e_failure;
+    }
+    decInfo.password = opts->password;
+
+    decInfo.fptr_stego_image = fmemopen(slot->in_buf, slot->in_size, "r");
+    if(decInfo.fptr_stego_image == NULL)
+    {
+        return e_failure;
+    }
+    Status status = decode_open_file(&decInfo);
+
+    //files are closed by decoding only when data was decoded
+    if(decInfo.fptr_stego_image != NULL)
+    {
+        fclose(decInfo.fptr_stego_image);
+    }
+    if(decInfo.fptr_output_secret != NULL)
+    {
+        fclose(decInfo.fptr_output_secret);
+    }
+    return status;
+}
+
+//to release slot buffers and file descriptors
+static void batch_free_slot(BatchSlot *slot)
+{
+    free(slot->in_buf);
+    free(slot->out_buf);
+    slot->in_buf = NULL;
+    slot->out_buf = NULL;
+    slot->state = e_slot_free;
+}
+
+/*
+ * Run all jobs of job list file
+ * Input: job list file name, options (-k, -r, -q, -n)
+ * Return Value: e_failure if any job failed
+ */
+Status do_batch(const char *job_fname, const StegoOptions *opts)
+{
+    FILE *fptr_jobs = fopen(job_fname, "r");
+    if(fptr_jobs == NULL)
+    {
+        perror("fopen");
+        fprintf(stderr, "ERROR: Unable to open file %s\n", job_fname);
+        return e_failure;
+    }
+
+    uint depth = opts->queue_depth ? opts->queue_depth : BATCH_DEFAULT_QUEUE_DEPTH;
+    uint buffers = opts->buffers ? opts->buffers : BATCH_DEFAULT_BUFFERS;
+    IoEngine io;
+    BatchSlot *slots = calloc(buffers, sizeof(BatchSlot));
+    if(slots == NULL || io_engine_init(&io, depth) == e_failure)
+    {
+        free(slots);
+        fclose(fptr_jobs);
+        return e_failure;
+    }
+    printf("INFO: ## Batch Procedure Started ##\n");
+
+    int jobs_ok = 0, jobs_failed = 0;
+    int no_more_jobs = 0;
+    while(1)
+    {
+        //to keep every free buffer loading the next image
+        for(uint i = 0; i < buffers && !no_more_jobs && io.in_flight < io.depth; i++)
+        {
+            if(slots[i].state != e_slot_free)
+            {
+                continue;
+            }
+            while(!no_more_jobs)
+            {
+                if(fgets(slots[i].line, BATCH_LINE_SIZE, fptr_jobs) == NULL)
+                {
+                    no_more_jobs = 1;
+                }
+                else if(strspn(slots[i].line, " \t\r\n") == strlen(slots[i].line))
+                {
+                    continue;   //blank line
+                }
+                else if(batch_start_job(&io, &slots[i], i) == e_failure)
+                {
+                    jobs_failed++;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+        if(io.in_flight == 0)
+        {
+            break;
+        }
+
+        IoCompletion completion;
+        if(io_wait_completion(&io, &completion) == e_failure)
+        {
+            break;
+        }
+        BatchSlot *slot = &slots[completion.tag];
+
+        if(slot->state == e_slot_reading)
+        {
+            if(completion.result <= 0)
+            {
+                printf("ERROR: Read of %s failed\n", slot->args[2]);
+                close(slot->in_fd);
+                batch_free_slot(slot);
+                jobs_failed++;
+                continue;
+            }
+            slot->in_done += completion.result;
+            if(slot->in_done < slot->in_size)   //short read, queue the rest
+            {
+                if(io_submit_read(&io, slot->in_fd, slot->in_buf + slot->in_done, slot->in_size - slot->in_done, slot->in_done, completion.tag) == e_failure)
+                {
+                    printf("ERROR: Read of %s failed\n", slot->args[2]);
+                    close(slot->in_fd);
+                    batch_free_slot(slot);
+                    jobs_failed++;
+                }
+                continue;
+            }
+            close(slot->in_fd);
+
+            //image is loaded, do the LSB work while other requests are in flight
+            if(check_operation_type(slot->args) == e_decode)
+            {
+                if(batch_decode(slot, opts) == e_success)
+                {
+                    jobs_ok++;
+                }
+                else
+                {
+                    jobs_failed++;
+                }
+                batch_free_slot(slot);
+            }
+            else if(batch_encode(slot, opts) == e_success)
+            {
+                if(io_submit_write(&io, slot->out_fd, slot->out_buf, slot->out_size, 0, completion.tag) == e_success)
+                {
+                    slot->state = e_slot_writing;
+                }
+                else
+                {
+                    printf("ERROR: Write of stego image for %s failed\n", slot->args[2]);
+                    close(slot->out_fd);
+                    batch_free_slot(slot);
+                    jobs_failed++;
+                }
+            }
+            else
+            {
+                jobs_failed++;
+                batch_free_slot(slot);
+            }
+        }
+        else if(slot->state == e_slot_writing)
+        {
+            if(completion.result <= 0)
+            {
+                printf("ERROR: Write of stego image for %s failed\n", slot->args[2]);
+                close(slot->out_fd);
+                batch_free_slot(slot);
+                jobs_failed++;
+                continue;
+            }
+            slot->out_done += completion.result;
+            if(slot->out_done < (long)slot->out_size)   //short write, queue the rest
+            {
+                if(io_submit_write(&io, slot->out_fd, slot->out_buf + slot->out_done, slot->out_size - slot->out_done, slot->out_done, completion.tag) == e_failure)
+                {
+                    printf("ERROR: Write of stego image for %s failed\n", slot->args[2]);
+                    close(slot->out_fd);
+                    batch_free_slot(slot);
+                    jobs_failed++;
+                }
+                continue;
+            }
+            close(slot->out_fd);
+            batch_free_slot(slot);
+            jobs_ok++;
+        }
+    }
+
+    io_engine_close(&io);
+    free(slots);
+    fclose(fptr_jobs);
+    printf("INFO: ## Batch Done, %d jobs succeeded, %d failed ##\n", jobs_ok, jobs_failed);
+    return (jobs_failed == 0) ? e_success : e_failure;
+}
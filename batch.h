@@ -0,0 +1,49 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "types.h" // Contains user defined types
+
+/* Defaults for -q and -n */
+#define BATCH_DEFAULT_QUEUE_DEPTH 16
+#define BATCH_DEFAULT_BUFFERS 8
+
+/* Max length of one job line */
+#define BATCH_LINE_SIZE 512
+
+typedef enum
+{
+    e_slot_free,
+    e_slot_reading,
+    e_slot_writing
+} SlotState;
+
+/*
+ * One image buffer of the batch pipeline.
+ * A job line is "-e <image> <secret> [stego]" or "-d <stego> [output]",
+ * same as the command line.
+ */
+typedef struct _BatchSlot
+{
+    SlotState state;
+    char line[BATCH_LINE_SIZE];   //job line, args point into it
+    char *args[6];               //argv style job arguments
+    int argc;
+
+    /* image read */
+    int in_fd;
+    char *in_buf;
+    long in_size;
+    long in_done;
+
+    /* stego image write */
+    int out_fd;
+    char *out_buf;
+    size_t out_size;
+    long out_done;
+
+} BatchSlot;
+
+/* Run all jobs of job list file */
+Status do_batch(const char *job_fname, const StegoOptions *opts);
+
+#endif
@@ -0,0 +1,359 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : ChaCha20 stream cipher (RFC 8439) used to encrypt the secret
+              file data while it is being embedded into the image.
+
+              The keystream is XORed byte by byte inside the LSB embed and
+              extract loops, so encryption needs no extra pass over the data,
+              no temporary file and no extra buffer.
+
+              The key is derived from the whole password given with -k by
+              PBKDF2-HMAC-SHA256 with a random salt. The nonce and the salt
+              are random per stego image and are stored in the stego header.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "cipher.h"
+#include "types.h"
+
+/* Rotate 32 bit word left */
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+/* ChaCha quarter round on 4 words of working state */
+#define QUARTER_ROUND(a, b, c, d)                  \
+    do                                             \
+    {                                              \
+        a += b; d ^= a; d = ROTL32(d, 16);         \
+        c += d; b ^= c; b = ROTL32(b, 12);         \
+        a += b; d ^= a; d = ROTL32(d, 8);          \
+        c += d; b ^= c; b = ROTL32(b, 7);          \
+    } while(0)
+
+/* SHA-256 round constants (FIPS 180-4) */
+static const uint sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* SHA-256 state while hashing a message */
+typedef struct _Sha256
+{
+    uint h[8];
+    unsigned char block[64];   //partial input block
+    int len;                  //bytes in block
+    unsigned long long total;   //message length in bytes
+
+} Sha256;
+
+#define ROTR32(v, n) (((v) >> (n)) | ((v) << (32 - (n))))
+
+//to load 4 bytes as big endian word
+static uint load32_be(const unsigned char *p)
+{
+    return ((uint)p[0] << 24) | ((uint)p[1] << 16) | ((uint)p[2] << 8) | (uint)p[3];
+}
+
+//to store word as 4 big endian bytes
+static void store32_be(unsigned char *p, uint v)
+{
+    p[0] = v >> 24;
+    p[1] = (v >> 16) & 0xff;
+    p[2] = (v >> 8) & 0xff;
+    p[3] = v & 0xff;
+}
+
+//to run SHA-256 compression on one 64 byte block
+static void sha256_compress(uint *h, const unsigned char *block)
+{
+    uint w[64];
+    for(int i = 0; i < 16; i++)
+    {
+        w[i] = load32_be(block + 4 * i);
+    }
+    for(int i = 16; i < 64; i++)
+    {
+        uint s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+    for(int i = 0; i < 64; i++)
+    {
+        uint t1 = hh + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+        uint t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        hh = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+
+static void sha256_init(Sha256 *ctx)
+{
+    static const uint iv[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    memcpy(ctx->h, iv, sizeof(iv));
+    ctx->len = 0;
+    ctx->total = 0;
+}
+
+static void sha256_update(Sha256 *ctx, const unsigned char *data, int size)
+{
+    ctx->total += size;
+    for(int i = 0; i < size; i++)
+    {
+        ctx->block[ctx->len++] = data[i];
+        if(ctx->len == 64)
+        {
+            sha256_compress(ctx->h, ctx->block);
+            ctx->len = 0;
+        }
+    }
+}
+
+static void sha256_final(Sha256 *ctx, unsigned char *digest)
+{
+    unsigned long long bits = ctx->total * 8;
+    unsigned char pad = 0x80;
+    sha256_update(ctx, &pad, 1);
+    pad = 0;
+    while(ctx->len != 56)
+    {
+        sha256_update(ctx, &pad, 1);
+    }
+    for(int i = 7; i >= 0; i--)
+    {
+        ctx->block[ctx->len++] = (bits >> (8 * i)) & 0xff;
+    }
+    sha256_compress(ctx->h, ctx->block);
+    for(int i = 0; i < 8; i++)
+    {
+        store32_be(digest + 4 * i, ctx->h[i]);
+    }
+}
+
+//to hash size bytes of data, 32 byte digest
+void cipher_sha256(const unsigned char *data, int size, unsigned char *digest)
+{
+    Sha256 ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, size);
+    sha256_final(&ctx, digest);
+}
+
+/*
+ * PBKDF2-HMAC-SHA256 (RFC 8018)
+ * Input: password, salt, iteration count, key length
+ * Output: out_len bytes of key in out
+ * Description: HMAC inner / outer states of the password are hashed
+ * once, so every iteration costs two compressions.
+ */
+void cipher_pbkdf2_sha256(const unsigned char *password, int password_len, const unsigned char *salt, int salt_len, uint iterations, unsigned char *out, int out_len)
+{
+    unsigned char key_block[64] = {0};
+    unsigned char pad[64];
+    Sha256 inner, outer, ctx;
+
+    //passwords longer than a block are hashed first (HMAC key)
+    if(password_len > 64)
+    {
+        sha256_init(&ctx);
+        sha256_update(&ctx, password, password_len);
+        sha256_final(&ctx, key_block);
+    }
+    else
+    {
+        memcpy(key_block, password, password_len);
+    }
+    for(int i = 0; i < 64; i++)
+    {
+        pad[i] = key_block[i] ^ 0x36;
+    }
+    sha256_init(&inner);
+    sha256_update(&inner, pad, 64);
+    for(int i = 0; i < 64; i++)
+    {
+        pad[i] = key_block[i] ^ 0x5c;
+    }
+    sha256_init(&outer);
+    sha256_update(&outer, pad, 64);
+
+    unsigned char u[32], t[32], counter[4];
+    for(uint block = 1; out_len > 0; block++)
+    {
+        //U1 = HMAC(password, salt || block)
+        store32_be(counter, block);
+        ctx = inner;
+        sha256_update(&ctx, salt, salt_len);
+        sha256_update(&ctx, counter, 4);
+        sha256_final(&ctx, u);
+        ctx = outer;
+        sha256_update(&ctx, u, 32);
+        sha256_final(&ctx, u);
+        memcpy(t, u, 32);
+
+        //Un = HMAC(password, Un-1)
+        for(uint i = 1; i < iterations; i++)
+        {
+            ctx = inner;
+            sha256_update(&ctx, u, 32);
+            sha256_final(&ctx, u);
+            ctx = outer;
+            sha256_update(&ctx, u, 32);
+            sha256_final(&ctx, u);
+            for(int j = 0; j < 32; j++)
+            {
+                t[j] ^= u[j];
+            }
+        }
+        int n = (out_len < 32) ? out_len : 32;
+        memcpy(out, t, n);
+        out += n;
+        out_len -= n;
+    }
+
+    //to clear key material from stack
+    memset(key_block, 0, sizeof(key_block));
+    memset(pad, 0, sizeof(pad));
+    memset(&inner, 0, sizeof(inner));
+    memset(&outer, 0, sizeof(outer));
+    memset(&ctx, 0, sizeof(ctx));
+    memset(u, 0, sizeof(u));
+    memset(t, 0, sizeof(t));
+}
+
+//to load 4 bytes as little endian word
+static uint load32_le(const unsigned char *p)
+{
+    return (uint)p[0] | ((uint)p[1] << 8) | ((uint)p[2] << 16) | ((uint)p[3] << 24);
+}
+
+//to set constants, key, counter and nonce words
+static void cipher_setup_state(uint *state, const unsigned char *key, uint counter, const unsigned char *nonce)
+{
+    state[0] = 0x61707865;   //"expand 32-byte k"
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for(int i = 0; i < 8; i++)
+    {
+        state[4 + i] = load32_le(key + 4 * i);
+    }
+    state[12] = counter;
+    for(int i = 0; i < 3; i++)
+    {
+        state[13 + i] = load32_le(nonce + 4 * i);
+    }
+}
+
+//to run 20 rounds on state and serialise result as 64 bytes
+static void chacha20_block(const uint *state, unsigned char *out)
+{
+    uint x[16];
+    memcpy(x, state, sizeof(x));
+    for(int i = 0; i < 10; i++)
+    {
+        //column rounds
+        QUARTER_ROUND(x[0], x[4], x[8],  x[12]);
+        QUARTER_ROUND(x[1], x[5], x[9],  x[13]);
+        QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        //diagonal rounds
+        QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND(x[2], x[7], x[8],  x[13]);
+        QUARTER_ROUND(x[3], x[4], x[9],  x[14]);
+    }
+    for(int i = 0; i < 16; i++)
+    {
+        uint v = x[i] + state[i];
+        out[4 * i] = v & 0xff;
+        out[4 * i + 1] = (v >> 8) & 0xff;
+        out[4 * i + 2] = (v >> 16) & 0xff;
+        out[4 * i + 3] = (v >> 24) & 0xff;
+    }
+}
+
+Status cipher_generate_nonce(unsigned char *nonce, unsigned char *salt)
+{
+    FILE *fptr = fopen("/dev/urandom", "r");
+    if(fptr != NULL)
+    {
+        size_t n = fread(nonce, 1, CIPHER_NONCE_SIZE, fptr);
+        n += fread(salt, 1, CIPHER_SALT_SIZE, fptr);
+        fclose(fptr);
+        if(n == CIPHER_NONCE_SIZE + CIPHER_SALT_SIZE)
+        {
+            return e_success;
+        }
+    }
+
+    //fallback when /dev/urandom is not available, nonce and salt only have to be unique
+    printf("INFO: /dev/urandom not available, using time based nonce\n");
+    uint seed[3] = {(uint)time(NULL), (uint)getpid(), (uint)clock()};
+    memcpy(nonce, seed, CIPHER_NONCE_SIZE);
+    memset(salt, 0, CIPHER_SALT_SIZE);
+    memcpy(salt, seed, sizeof(seed));
+    return e_success;
+}
+
+/*
+ * Derive key from password and set up keystream state
+ * Input: password string, 12 byte nonce and 16 byte salt
+ * Description: every password byte goes through PBKDF2-HMAC-SHA256
+ * with CIPHER_KDF_ITERATIONS iterations, output is the ChaCha20 key.
+ */
+Status cipher_init(CipherInfo *cipher, const char *password, const unsigned char *nonce, const unsigned char *salt)
+{
+    int len = strlen(password);
+    if(len == 0)
+    {
+        printf("ERROR: Empty password\n");
+        return e_failure;
+    }
+
+    unsigned char key[CIPHER_KEY_SIZE];
+    cipher_pbkdf2_sha256((const unsigned char *)password, len, salt, CIPHER_SALT_SIZE, CIPHER_KDF_ITERATIONS, key, CIPHER_KEY_SIZE);
+
+    memcpy(cipher->nonce, nonce, CIPHER_NONCE_SIZE);
+    memcpy(cipher->salt, salt, CIPHER_SALT_SIZE);
+    cipher_setup_state(cipher->state, key, 0, cipher->nonce);
+    cipher->ks_pos = 64;   //keystream block generated on first use
+
+    //to clear key material from stack
+    memset(key, 0, sizeof(key));
+    return e_success;
+}
+
+void cipher_next_block(CipherInfo *cipher)
+{
+    chacha20_block(cipher->state, cipher->keystream);
+    cipher->state[12]++;   //block counter
+    cipher->ks_pos = 0;
+}
+
+char cipher_next_byte(CipherInfo *cipher)
+{
+    if(cipher->ks_pos == 64)
+    {
+        cipher_next_block(cipher);
+    }
+    return cipher->keystream[cipher->ks_pos++];
+}
@@ -0,0 +1,47 @@
+#ifndef CIPHER_H
+#define CIPHER_H
+
+#include "types.h" // Contains user defined types
+
+/* Nonce size of the ChaCha20 stream cipher (RFC 8439) */
+#define CIPHER_NONCE_SIZE 12
+
+/* Key derivation, PBKDF2-HMAC-SHA256 (RFC 8018) with a random salt per stego image */
+#define CIPHER_SALT_SIZE 16
+#define CIPHER_KDF_ITERATIONS 100000
+#define CIPHER_KEY_SIZE 32
+
+/*
+ * Structure to store the ChaCha20 keystream state.
+ * Keystream bytes are handed out one at a time so that
+ * the XOR can be done inside the LSB embed/extract loop
+ */
+typedef struct _CipherInfo
+{
+    uint state[16];                          //key, counter and nonce words
+    unsigned char keystream[64];            //current keystream block
+    int ks_pos;                            //next unused byte in keystream block
+    unsigned char nonce[CIPHER_NONCE_SIZE]; //nonce stored in the stego header
+    unsigned char salt[CIPHER_SALT_SIZE];  //key derivation salt stored after the nonce
+
+} CipherInfo;
+
+/* Fill nonce and salt with random bytes */
+Status cipher_generate_nonce(unsigned char *nonce, unsigned char *salt);
+
+/* Derive key from password and salt, set up keystream state */
+Status cipher_init(CipherInfo *cipher, const char *password, const unsigned char *nonce, const unsigned char *salt);
+
+/* SHA-256 of data, 32 bytes of digest */
+void cipher_sha256(const unsigned char *data, int size, unsigned char *digest);
+
+/* PBKDF2-HMAC-SHA256 of password and salt, out_len bytes of key */
+void cipher_pbkdf2_sha256(const unsigned char *password, int password_len, const unsigned char *salt, int salt_len, uint iterations, unsigned char *out, int out_len);
+
+/* Generate the next 64 byte keystream block */
+void cipher_next_block(CipherInfo *cipher);
+
+/* Get next keystream byte */
+char cipher_next_byte(CipherInfo *cipher);
+
+#endif
@@ -0,0 +1,752 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Coordinator / worker mode, shares one job list between
+              worker processes on many machines.
+
+              The coordinator (-C) reads a job list (same format as batch
+              mode) and leases one job at a time to each connected worker
+              over a line protocol on a unix socket or TCP (host:port).
+              Workers (-W) run the job with the normal encoding / decoding
+              functions on files of a shared file system and report the
+              result.
+
+              A lease runs out if the worker does not renew it (workers
+              renew from a heartbeat thread while a job runs) and the job
+              is given to another worker, the same happens at once when a
+              worker disconnects. A job failing on CLUSTER_MAX_ATTEMPTS
+              workers is given up. Finished jobs are appended to
+              <job list>.done, a restarted coordinator skips them.
+
+              Every lease has a generation number. Workers write job output
+              to a temp file and rename it only after the coordinator
+              confirms that their lease is still current, so a worker whose
+              lease ran out can not overwrite the output of the new holder
+              or get its job marked done.
+
+              Every worker works on its own job, so throughput grows with
+              the number of workers until the shared storage is the limit.
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <signal.h>
+#include <poll.h>
+#include <pthread.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "cluster.h"
+#include "encode.h"
+#include "decode.h"
+#include "types.h"
+
+/* Heartbeat state shared by worker main thread and renew thread */
+typedef struct _WorkerLink
+{
+    int sock;
+    int job_id;          //running job, -1 if none
+    uint generation;    //lease generation of running job
+    uint lease;         //lease seconds of running job
+    int stop;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+
+} WorkerLink;
+
+/* Output of a job, written to temp_fname and renamed to fname on COMMIT */
+typedef struct _JobOutput
+{
+    char fname[CLUSTER_LINE_SIZE];
+    char temp_fname[CLUSTER_LINE_SIZE + 32];
+
+} JobOutput;
+
+//to open listening or connected stream socket, address is unix socket path or host:port
+static int cluster_socket(const char *address, int listening)
+{
+    const char *colon = strrchr(address, ':');
+    int sock = -1;
+    if(strchr(address, '/') != NULL || colon == NULL)
+    {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if(strlen(address) >= sizeof(addr.sun_path))
+        {
+            printf("ERROR: Socket path %s is too long\n", address);
+            return -1;
+        }
+        strcpy(addr.sun_path, address);
+        sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if(listening)
+        {
+            unlink(address);   //remove socket left by previous run
+        }
+        if(sock >= 0 && (listening ? (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(sock, 128) < 0) : connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0))
+        {
+            close(sock);
+            sock = -1;
+        }
+    }
+    else
+    {
+        char host[256];
+        size_t host_len = colon - address;
+        if(host_len >= sizeof(host))
+        {
+            printf("ERROR: Host name in %s is too long\n", address);
+            return -1;
+        }
+        memcpy(host, address, host_len);
+        host[host_len] = '\0';
+
+        struct addrinfo hints, *res;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = listening ? AI_PASSIVE : 0;
+        if(getaddrinfo(host_len ? host : NULL, colon + 1, &hints, &res) != 0)
+        {
+            printf("ERROR: Unable to resolve %s\n", address);
+            return -1;
+        }
+        for(struct addrinfo *ai = res; ai != NULL && sock < 0; ai = ai->ai_next)
+        {
+            int one = 1;
+            sock = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+            if(sock < 0)
+            {
+                continue;
+            }
+            setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   //protocol lines are small
+            if(listening ? (bind(sock, ai->ai_addr, ai->ai_addrlen) < 0 || listen(sock, 128) < 0) : connect(sock, ai->ai_addr, ai->ai_addrlen) < 0)
+            {
+                close(sock);
+                sock = -1;
+            }
+        }
+        freeaddrinfo(res);
+    }
+    if(sock < 0)
+    {
+        perror("socket");
+        if(listening)
+        {
+            fprintf(stderr, "ERROR: Unable to listen on %s\n", address);
+        }
+        else
+        {
+            fprintf(stderr, "ERROR: Unable to connect to coordinator on %s\n", address);
+        }
+    }
+    return sock;
+}
+
+//to send one protocol line
+static Status send_line(int sock, const char *fmt, ...)
+{
+    char line[CLUSTER_LINE_SIZE + 64];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if(len < 0 || len >= (int)sizeof(line))
+    {
+        return e_failure;
+    }
+    return (send(sock, line, len, MSG_NOSIGNAL) == len) ? e_success : e_failure;
+}
+
+//to read job list, blank lines are skipped
+static ClusterJob *load_jobs(const char *job_fname, int *count)
+{
+    FILE *fptr = fopen(job_fname, "r");
+    if(fptr == NULL)
+    {
+        perror("fopen");
+        fprintf(stderr, "ERROR: Unable to open file %s\n", job_fname);
+        return NULL;
+    }
+    int size = 64;
+    ClusterJob *jobs = malloc(sizeof(ClusterJob) * size);
+    char line[CLUSTER_LINE_SIZE];
+    *count = 0;
+    while(jobs != NULL && fgets(line, sizeof(line), fptr) != NULL)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        if(strspn(line, " \t") == strlen(line))
+        {
+            continue;
+        }
+        if(*count == size)
+        {
+            size *= 2;
+            ClusterJob *grown = realloc(jobs, sizeof(ClusterJob) * size);
+            if(grown == NULL)
+            {
+                break;
+            }
+            jobs = grown;
+        }
+        ClusterJob *job = &jobs[(*count)++];
+        memset(job, 0, sizeof(*job));
+        job->line = strdup(line);
+        job->state = e_job_pending;
+        job->worker = -1;
+    }
+    fclose(fptr);
+    return jobs;
+}
+
+//to mark jobs finished by previous run, journal lines are "<id> <job line>"
+static int load_journal(const char *journal_fname, ClusterJob *jobs, int count)
+{
+    FILE *fptr = fopen(journal_fname, "r");
+    if(fptr == NULL)
+    {
+        return 0;
+    }
+    int done = 0;
+    char line[CLUSTER_LINE_SIZE + 16];
+    while(fgets(line, sizeof(line), fptr) != NULL)
+    {
+        int id, pos;
+        line[strcspn(line, "\r\n")] = '\0';
+        if(sscanf(line, "%d %n", &id, &pos) == 1 && id >= 0 && id < count && jobs[id].state != e_job_done && !strcmp(jobs[id].line, line + pos))
+        {
+            jobs[id].state = e_job_done;
+            done++;
+        }
+    }
+    fclose(fptr);
+    return done;
+}
+
+//to put leased jobs of a worker back in the queue
+static void release_leases(ClusterJob *jobs, int count, int client, int *first_pending)
+{
+    for(int i = 0; i < count; i++)
+    {
+        if((jobs[i].state == e_job_leased || jobs[i].state == e_job_committing) && jobs[i].worker == client)
+        {
+            jobs[i].state = e_job_pending;
+            jobs[i].worker = -1;
+            *first_pending = (i < *first_pending) ? i : *first_pending;
+            printf("INFO: Job %d queued again\n", i);
+        }
+    }
+}
+
+//to find job id leased to client with generation, NULL if the message is not from the holder
+static ClusterJob *held_job(ClusterJob *jobs, int count, int id, uint generation, int client, JobState state)
+{
+    if(id < 0 || id >= count || jobs[id].state != state || jobs[id].worker != client || jobs[id].generation != generation)
+    {
+        return NULL;
+    }
+    return &jobs[id];
+}
+
+/*
+ * Run coordinator
+ * Input: job list file, address, options (-l lease seconds)
+ * Description: serves workers with a poll loop until every job is
+ * done or given up
+ * Return Value: e_failure if any job was given up
+ */
+Status do_coordinator(const char *job_fname, const char *address, const StegoOptions *opts)
+{
+    int count;
+    ClusterJob *jobs = load_jobs(job_fname, &count);
+    if(jobs == NULL)
+    {
+        return e_failure;
+    }
+    char journal_fname[CLUSTER_LINE_SIZE];
+    snprintf(journal_fname, sizeof(journal_fname), "%s.done", job_fname);
+    int done = load_journal(journal_fname, jobs, count);
+    int failed = 0;
+    FILE *fptr_journal = fopen(journal_fname, "a");
+    int sock = cluster_socket(address, 1);
+    if(fptr_journal == NULL || sock < 0)
+    {
+        if(fptr_journal == NULL)
+        {
+            perror("fopen");
+            fprintf(stderr, "ERROR: Unable to open file %s\n", journal_fname);
+        }
+        if(fptr_journal != NULL)
+        {
+            fclose(fptr_journal);
+        }
+        if(sock >= 0)
+        {
+            close(sock);
+        }
+        for(int i = 0; i < count; i++)
+        {
+            free(jobs[i].line);
+        }
+        free(jobs);
+        return e_failure;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    uint lease = opts->lease_seconds ? opts->lease_seconds : CLUSTER_DEFAULT_LEASE;
+    printf("INFO: ## Coordinator Listening on %s, %d jobs, %d already done ##\n", address, count, done);
+    fflush(stdout);
+
+    ClusterClient clients[CLUSTER_MAX_CLIENTS];
+    for(int i = 0; i < CLUSTER_MAX_CLIENTS; i++)
+    {
+        clients[i].fd = -1;
+    }
+    int workers_seen = 0;
+    int first_pending = 0;   //no pending job before this index
+    while(done + failed < count)
+    {
+        struct pollfd fds[CLUSTER_MAX_CLIENTS + 1];
+        int index[CLUSTER_MAX_CLIENTS + 1];
+        int nfds = 1;
+        fds[0].fd = sock;
+        fds[0].events = POLLIN;
+        for(int i = 0; i < CLUSTER_MAX_CLIENTS; i++)
+        {
+            if(clients[i].fd >= 0)
+            {
+                fds[nfds].fd = clients[i].fd;
+                fds[nfds].events = POLLIN;
+                index[nfds++] = i;
+            }
+        }
+        if(poll(fds, nfds, 1000) < 0)
+        {
+            perror("poll");
+            continue;
+        }
+        time_t now = time(NULL);
+
+        //to accept new worker
+        if(fds[0].revents & POLLIN)
+        {
+            int conn = accept4(sock, NULL, NULL, SOCK_CLOEXEC);
+            int slot = 0;
+            while(slot < CLUSTER_MAX_CLIENTS && clients[slot].fd >= 0)
+            {
+                slot++;
+            }
+            if(conn >= 0 && slot == CLUSTER_MAX_CLIENTS)
+            {
+                printf("ERROR: Too many workers\n");
+                close(conn);
+            }
+            else if(conn >= 0)
+            {
+                clients[slot].fd = conn;
+                clients[slot].id = ++workers_seen;
+                clients[slot].len = 0;
+                printf("INFO: Worker %d connected\n", clients[slot].id);
+            }
+        }
+
+        for(int p = 1; p < nfds; p++)
+        {
+            if(!(fds[p].revents & (POLLIN | POLLHUP | POLLERR)))
+            {
+                continue;
+            }
+            int c = index[p];
+            ClusterClient *client = &clients[c];
+            ssize_t len = recv(client->fd, client->buf + client->len, sizeof(client->buf) - 1 - client->len, 0);
+            if(len <= 0)
+            {
+                printf("INFO: Worker %d disconnected\n", client->id);
+                release_leases(jobs, count, c, &first_pending);
+                close(client->fd);
+                client->fd = -1;
+                continue;
+            }
+            client->len += len;
+            client->buf[client->len] = '\0';
+
+            //to handle every complete line received
+            char *line = client->buf, *end;
+            while((end = strchr(line, '\n')) != NULL)
+            {
+                *end = '\0';
+                int id;
+                uint gen;
+                ClusterJob *job;
+                if(!strcmp(line, "GET"))
+                {
+                    while(first_pending < count && jobs[first_pending].state != e_job_pending)
+                    {
+                        first_pending++;
+                    }
+                    if(first_pending < count)
+                    {
+                        job = &jobs[first_pending];
+                        job->state = e_job_leased;
+                        job->worker = c;
+                        job->generation++;
+                        job->lease_end = now + lease;
+                        send_line(client->fd, "JOB %d %u %u %s\n", first_pending, job->generation, lease, job->line);
+                        printf("INFO: Job %d leased to worker %d\n", first_pending, client->id);
+                    }
+                    else if(done + failed < count)
+                    {
+                        send_line(client->fd, "WAIT %d\n", CLUSTER_WAIT_SECONDS);
+                    }
+                    else
+                    {
+                        send_line(client->fd, "DONE\n");
+                    }
+                }
+                else if(sscanf(line, "RENEW %d %u", &id, &gen) == 2)
+                {
+                    if((job = held_job(jobs, count, id, gen, c, e_job_leased)) != NULL)
+                    {
+                        job->lease_end = now + lease;
+                    }
+                }
+                else if(sscanf(line, "OK %d %u", &id, &gen) == 2)
+                {
+                    //only the current holder may publish its output, a lost lease is fenced off
+                    if((job = held_job(jobs, count, id, gen, c, e_job_leased)) != NULL)
+                    {
+                        job->state = e_job_committing;
+                        job->lease_end = now + lease;   //heartbeat has stopped, the commit gets one more lease
+                        send_line(client->fd, "COMMIT %d\n", id);
+                    }
+                    else
+                    {
+                        send_line(client->fd, "STALE %d\n", id);
+                        printf("INFO: Stale result of job %d from worker %d dropped\n", id, client->id);
+                    }
+                }
+                else if(sscanf(line, "COMMITTED %d %u", &id, &gen) == 2)
+                {
+                    if((job = held_job(jobs, count, id, gen, c, e_job_committing)) != NULL)
+                    {
+                        job->state = e_job_done;
+                        job->worker = -1;
+                        done++;
+                        fprintf(fptr_journal, "%d %s\n", id, job->line);
+                        fflush(fptr_journal);
+                        printf("INFO: Job %d done by worker %d (%d of %d)\n", id, client->id, done, count);
+                    }
+                }
+                else if(sscanf(line, "FAIL %d %u", &id, &gen) == 2)
+                {
+                    //holder may also fail after COMMIT when its rename failed
+                    if((job = held_job(jobs, count, id, gen, c, e_job_leased)) != NULL || (job = held_job(jobs, count, id, gen, c, e_job_committing)) != NULL)
+                    {
+                        job->worker = -1;
+                        if(++job->attempts >= CLUSTER_MAX_ATTEMPTS)
+                        {
+                            job->state = e_job_failed;
+                            failed++;
+                            printf("ERROR: Job %d failed %d times, giving up: %s\n", id, job->attempts, job->line);
+                        }
+                        else
+                        {
+                            job->state = e_job_pending;
+                            first_pending = (id < first_pending) ? id : first_pending;
+                            printf("INFO: Job %d failed on worker %d, queued again\n", id, client->id);
+                        }
+                    }
+                }
+                else
+                {
+                    printf("ERROR: Invalid message from worker %d\n", client->id);
+                }
+                line = end + 1;
+            }
+            client->len -= line - client->buf;
+            memmove(client->buf, line, client->len);
+            if(client->len == (int)sizeof(client->buf) - 1)
+            {
+                printf("ERROR: Worker %d sent a too long line\n", client->id);
+                release_leases(jobs, count, c, &first_pending);
+                close(client->fd);
+                client->fd = -1;
+            }
+        }
+
+        //to take back jobs of workers which stopped renewing or never confirmed a commit
+        for(int i = 0; i < count; i++)
+        {
+            if((jobs[i].state == e_job_leased || jobs[i].state == e_job_committing) && jobs[i].lease_end < now)
+            {
+                printf("INFO: Lease of job %d expired\n", i);
+                release_leases(jobs, count, jobs[i].worker, &first_pending);
+            }
+        }
+    }
+
+    //workers see end of connection as DONE
+    for(int i = 0; i < CLUSTER_MAX_CLIENTS; i++)
+    {
+        if(clients[i].fd >= 0)
+        {
+            send_line(clients[i].fd, "DONE\n");
+            close(clients[i].fd);
+        }
+    }
+    close(sock);
+    if(strchr(address, '/') != NULL || strchr(address, ':') == NULL)
+    {
+        unlink(address);
+    }
+    fclose(fptr_journal);
+    for(int i = 0; i < count; i++)
+    {
+        free(jobs[i].line);
+    }
+    free(jobs);
+    printf("INFO: ## Coordinator Done, %d jobs succeeded, %d failed ##\n", done, failed);
+    return (failed == 0) ? e_success : e_failure;
+}
+
+//heartbeat thread, renews lease of running job
+static void *worker_heartbeat(void *arg)
+{
+    WorkerLink *link = arg;
+    pthread_mutex_lock(&link->lock);
+    while(!link->stop)
+    {
+        uint interval = (link->job_id >= 0 && link->lease >= 3) ? link->lease / 3 : 1;
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_sec += interval;
+        pthread_cond_timedwait(&link->wake, &link->lock, &until);
+        if(!link->stop && link->job_id >= 0)
+        {
+            send_line(link->sock, "RENEW %d %u\n", link->job_id, link->generation);
+        }
+    }
+    pthread_mutex_unlock(&link->lock);
+    return NULL;
+}
+
+/*
+ * Run one job line with the normal encoding / decoding functions
+ * Input: job line, lease generation, options
+ * Output: out, output name of the job and the temp file holding the output
+ * Description: output goes to "<output>.<gen>.<pid>.tmp" and is renamed by
+ * the caller once the coordinator confirms the lease, the temp file is
+ * removed when the job fails
+ */
+static Status worker_run_job(const char *job_line, uint generation, const StegoOptions *opts, JobOutput *out)
+{
+    char line[CLUSTER_LINE_SIZE];
+    char *args[6] = {"stego", NULL, NULL, NULL, NULL, NULL};
+    int argc = 1;
+    snprintf(line, sizeof(line), "%s", job_line);
+    char *token = strtok(line, " \t");
+    while(token != NULL && argc < 5)
+    {
+        args[argc++] = token;
+        token = strtok(NULL, " \t");
+    }
+    if(token != NULL || argc < 3)
+    {
+        printf("ERROR: Invalid job line\n");
+        return e_failure;
+    }
+
+    Status status = e_failure;
+    OperationType op_type = check_operation_type(args);
+    if(op_type == e_encode)
+    {
+        EncodeInfo encInfo;
+        memset(&encInfo, 0, sizeof(encInfo));
+        if(read_and_validate_encode_args(args, &encInfo, argc) == e_success && set_encode_options(&encInfo, opts) == e_success)
+        {
+            snprintf(out->fname, sizeof(out->fname), "%s", encInfo.stego_image_fname);
+            snprintf(out->temp_fname, sizeof(out->temp_fname), "%s.%u.%d.tmp", out->fname, generation, (int)getpid());
+            encInfo.stego_image_fname = out->temp_fname;
+            status = do_encoding(&encInfo);
+        }
+    }
+    else if(op_type == e_decode)
+    {
+        DecodeInfo decInfo;
+        memset(&decInfo, 0, sizeof(decInfo));
+        //extension of up to 4 bytes is appended to the output name later
+        if(args[3] != NULL && strlen(args[3]) + 5 > sizeof(decInfo.output_secret_fname))
+        {
+            printf("ERROR: Output name %s is too long\n", args[3]);
+        }
+        else if(read_and_validate_decode_args(args, &decInfo, argc) == e_success)
+        {
+            //name is complete only after the extension is decoded, so the temp file is opened here
+            snprintf(out->temp_fname, sizeof(out->temp_fname), "%s.%u.%d.tmp", decInfo.output_secret_fname, generation, (int)getpid());
+            decInfo.fptr_output_secret = fopen(out->temp_fname, "w");
+            if(decInfo.fptr_output_secret == NULL)
+            {
+                perror("fopen");
+                fprintf(stderr, "ERROR: Unable to open file %s\n", out->temp_fname);
+                return e_failure;
+            }
+            decInfo.password = opts->password;
+            status = do_decoding(&decInfo);
+            if(decInfo.fptr_output_secret != NULL)
+            {
+                fclose(decInfo.fptr_output_secret);   //decoding stopped before the data
+            }
+            snprintf(out->fname, sizeof(out->fname), "%s", decInfo.output_secret_fname);
+        }
+    }
+    else
+    {
+        printf("ERROR: Invalid job line\n");
+        return e_failure;
+    }
+    if(status == e_failure && out->temp_fname[0] != '\0')
+    {
+        unlink(out->temp_fname);
+    }
+    return status;
+}
+
+/*
+ * Run worker
+ * Input: coordinator address, options (-k, -r, -c for the jobs)
+ * Description: asks for jobs until coordinator has none left
+ */
+Status do_worker(const char *address, const StegoOptions *opts)
+{
+    WorkerLink link;
+    link.sock = cluster_socket(address, 0);
+    if(link.sock < 0)
+    {
+        return e_failure;
+    }
+    FILE *fptr_in = fdopen(link.sock, "r");
+    link.job_id = -1;
+    link.generation = 0;
+    link.lease = 0;
+    link.stop = 0;
+    pthread_mutex_init(&link.lock, NULL);
+    pthread_cond_init(&link.wake, NULL);
+    pthread_t heartbeat;
+    if(fptr_in == NULL || pthread_create(&heartbeat, NULL, worker_heartbeat, &link) != 0)
+    {
+        printf("ERROR: Unable to start worker\n");
+        if(fptr_in != NULL)
+        {
+            fclose(fptr_in);
+        }
+        else
+        {
+            close(link.sock);
+        }
+        return e_failure;
+    }
+    printf("INFO: ## Worker Connected to %s ##\n", address);
+
+    int jobs_ok = 0, jobs_failed = 0;
+    char line[CLUSTER_LINE_SIZE + 64];
+    while(1)
+    {
+        pthread_mutex_lock(&link.lock);
+        Status sent = send_line(link.sock, "GET\n");
+        pthread_mutex_unlock(&link.lock);
+        if(sent == e_failure || fgets(line, sizeof(line), fptr_in) == NULL)
+        {
+            break;   //coordinator finished or went away
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+
+        int id, pos;
+        uint generation, value;
+        if(sscanf(line, "JOB %d %u %u %n", &id, &generation, &value, &pos) == 3)
+        {
+            pthread_mutex_lock(&link.lock);
+            link.job_id = id;
+            link.generation = generation;
+            link.lease = value;
+            pthread_cond_signal(&link.wake);
+            pthread_mutex_unlock(&link.lock);
+
+            printf("INFO: Running job %d: %s\n", id, line + pos);
+            JobOutput out;
+            memset(&out, 0, sizeof(out));
+            Status status = worker_run_job(line + pos, generation, opts, &out);
+
+            pthread_mutex_lock(&link.lock);
+            link.job_id = -1;
+            send_line(link.sock, (status == e_success) ? "OK %d %u\n" : "FAIL %d %u\n", id, generation);
+            pthread_mutex_unlock(&link.lock);
+            if(status == e_failure)
+            {
+                jobs_failed++;
+                continue;
+            }
+
+            //output is published only while the lease is still ours
+            if(fgets(line, sizeof(line), fptr_in) == NULL)
+            {
+                unlink(out.temp_fname);
+                break;
+            }
+            int reply_id;
+            if(sscanf(line, "COMMIT %d", &reply_id) == 1 && reply_id == id)
+            {
+                int renamed = rename(out.temp_fname, out.fname) == 0;
+                if(!renamed)
+                {
+                    perror("rename");
+                    fprintf(stderr, "ERROR: Unable to rename %s to %s\n", out.temp_fname, out.fname);
+                    unlink(out.temp_fname);
+                }
+                pthread_mutex_lock(&link.lock);
+                send_line(link.sock, renamed ? "COMMITTED %d %u\n" : "FAIL %d %u\n", id, generation);
+                pthread_mutex_unlock(&link.lock);
+                if(renamed)
+                {
+                    jobs_ok++;
+                }
+                else
+                {
+                    jobs_failed++;
+                }
+            }
+            else
+            {
+                printf("INFO: Lease of job %d was lost, output dropped\n", id);
+                unlink(out.temp_fname);
+            }
+        }
+        else if(sscanf(line, "WAIT %u", &value) == 1)
+        {
+            sleep(value);
+        }
+        else
+        {
+            break;   //DONE
+        }
+    }
+
+    pthread_mutex_lock(&link.lock);
+    link.stop = 1;
+    pthread_cond_signal(&link.wake);
+    pthread_mutex_unlock(&link.lock);
+    pthread_join(heartbeat, NULL);
+    fclose(fptr_in);
+    pthread_mutex_destroy(&link.lock);
+    pthread_cond_destroy(&link.wake);
+    printf("INFO: ## Worker Done, %d jobs succeeded, %d failed ##\n", jobs_ok, jobs_failed);
+    return (jobs_failed == 0) ? e_success : e_failure;
+}
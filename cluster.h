@@ -0,0 +1,70 @@
+#ifndef CLUSTER_H
+#define CLUSTER_H
+
+#include <time.h>
+#include "types.h" // Contains user defined types
+
+/* Defaults for coordinator */
+#define CLUSTER_DEFAULT_LEASE 60   //seconds a worker may hold a job without renewing
+#define CLUSTER_MAX_ATTEMPTS 3    //job is given up after failing on this many workers
+#define CLUSTER_MAX_CLIENTS 256
+#define CLUSTER_WAIT_SECONDS 1   //worker retry delay when every open job is leased
+
+/* Max length of one protocol line, job lines are same size as in batch mode */
+#define CLUSTER_LINE_SIZE 640
+
+/*
+ * Line protocol, worker -> coordinator:
+ *     GET                         ask for a job
+ *     RENEW <id> <gen>            extend lease of running job, no reply
+ *     OK <id> <gen>               job output is in a temp file, reply COMMIT or STALE
+ *     COMMITTED <id> <gen>        temp file renamed to output, no reply
+ *     FAIL <id> <gen>             job failed, no reply
+ * coordinator -> worker:
+ *     JOB <id> <gen> <lease seconds> <job line>
+ *     COMMIT <id>                 lease is still held, rename temp file to output
+ *     STALE <id>                  lease was lost, drop temp file
+ *     WAIT <seconds>              every open job is leased, ask again later
+ *     DONE                        no jobs left
+ * <gen> is the lease generation, messages of an older lease or of a worker
+ * not holding the lease are rejected.
+ */
+
+typedef enum
+{
+    e_job_pending,
+    e_job_leased,
+    e_job_committing,   //holder was told to rename its output
+    e_job_done,
+    e_job_failed
+} JobState;
+
+/* One line of job list tracked by coordinator */
+typedef struct _ClusterJob
+{
+    char *line;          //job line, same syntax as batch mode
+    JobState state;
+    int worker;        //client index holding the lease
+    uint generation;  //lease number, results of older leases are stale
+    time_t lease_end;
+    int attempts;    //times reported failed
+
+} ClusterJob;
+
+/* Worker connection of coordinator */
+typedef struct _ClusterClient
+{
+    int fd;                          //-1 if slot is free
+    int id;                         //worker number for logs
+    char buf[CLUSTER_LINE_SIZE];   //partial line received
+    int len;
+
+} ClusterClient;
+
+/* Hand out jobs of job list to workers on address (unix socket path or host:port) */
+Status do_coordinator(const char *job_fname, const char *address, const StegoOptions *opts);
+
+/* Run jobs leased from coordinator on address until none are left */
+Status do_worker(const char *address, const StegoOptions *opts);
+
+#endif
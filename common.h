@@ -4,4 +4,22 @@
 /* Magic string to identify whether stegged or not */
 #define MAGIC_STRING "#*"
 
+/* Magic string for stego images which carry a flags field after the magic */
+#define MAGIC_STRING_EXT "#+"
+
+/* Stego header flags */
+#define STEGO_FLAG_CIPHER 0x01   //secret data encrypted with ChaCha20, nonce and key salt follow flags
+#define STEGO_FLAG_ECC    0x02   //secret data protected with interleaved RS(255,223)
+#define STEGO_FLAG_CHUNKED 0x04  //chunk size, chunk count and chunk digests follow, allows -u update
+#define STEGO_FLAG_MATRIX 0x08   //secret data matrix embedded with Hamming code, k follows
+
+/* Flags understood by this decoder */
+#define STEGO_FLAGS_SUPPORTED (STEGO_FLAG_CIPHER | STEGO_FLAG_ECC | STEGO_FLAG_CHUNKED | STEGO_FLAG_MATRIX)
+
+/* Magic string of per frame sequence header in frame stream mode */
+#define STREAM_FRAME_MAGIC "#="
+
+/* Frame stream header flags */
+#define STREAM_FRAME_LAST 0x01   //last frame carrying payload
+
 #endif
@@ -0,0 +1,629 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Daemon mode, a long running process which serves encode and
+              decode requests on a unix domain socket, so callers do not pay
+              process start up and cold tables for every image.
+
+              Images are not sent through the socket. The client passes
+              file descriptors (SCM_RIGHTS) of the image, secret and output,
+              which can be plain files or memfd shared memory. The daemon
+              preads them into buffers of a warm pool and runs the normal
+              encoding / decoding functions on fmemopen streams over those
+              buffers, so pixel data is never copied through the socket.
+              Client fds are not mmapped, a client truncating its file can
+              not take the daemon down with SIGBUS.
+
+              Connections are handed to a pool of worker threads which stay
+              alive between requests, with the GF(256) tables built once.
+              Buffers are reused across requests, so steady state requests
+              do not allocate or fault in fresh pages.
+
+              Client side: -s <socket> with -e / -d sends the request to
+              the daemon instead of encoding in process.
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/mman.h>   //memfd_create
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/un.h>
+#include "daemon.h"
+#include "encode.h"
+#include "decode.h"
+#include "common.h"
+#include "rs.h"
+#include "types.h"
+
+/* Connection queue shared by acceptor and workers */
+static int conn_queue[DAEMON_QUEUE_SIZE];
+static int conn_head = 0, conn_count = 0;
+static pthread_mutex_t conn_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t conn_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t conn_space = PTHREAD_COND_INITIALIZER;
+
+/* Buffer pool shared by workers, DAEMON_BUFFERS_PER_WORKER per worker so a request never waits */
+static DaemonBuffer *buffer_pool;
+static uint buffer_count;
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_free = PTHREAD_COND_INITIALIZER;
+
+//to send message with file descriptors
+static Status send_with_fds(int sock, const void *msg, size_t size, const int *fds, int nfds)
+{
+    struct iovec iov = {(void *)msg, size};
+    char control[CMSG_SPACE(sizeof(int) * 3)];
+    struct msghdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memset(control, 0, sizeof(control));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nfds);
+
+    return (sendmsg(sock, &hdr, 0) == (ssize_t)size) ? e_success : e_failure;
+}
+
+//to receive message with up to 3 file descriptors, nfds gets count
+static Status recv_with_fds(int sock, void *msg, size_t size, int *fds, int *nfds)
+{
+    struct iovec iov = {msg, size};
+    char control[CMSG_SPACE(sizeof(int) * 3)];
+    struct msghdr hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+
+    *nfds = 0;
+    ssize_t n = recvmsg(sock, &hdr, MSG_CMSG_CLOEXEC);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr);
+    if(n > 0 && cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+    {
+        *nfds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * *nfds);
+    }
+    return (n == (ssize_t)size) ? e_success : e_failure;
+}
+
+//to give buffer back to pool, very large buffers are not kept
+static void pool_release(DaemonBuffer *buf)
+{
+    pthread_mutex_lock(&pool_lock);
+    if(buf->capacity > DAEMON_POOL_KEEP_SIZE)
+    {
+        free(buf->data);
+        buf->data = NULL;
+        buf->capacity = 0;
+    }
+    buf->in_use = 0;
+    pthread_cond_signal(&pool_free);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+/*
+ * Take a buffer of at least size bytes from the pool
+ * Description: a free buffer which is already large enough is
+ * preferred, otherwise a free one is grown
+ * Return Value: NULL if memory could not be allocated
+ */
+static DaemonBuffer *pool_acquire(long size)
+{
+    pthread_mutex_lock(&pool_lock);
+    DaemonBuffer *buf = NULL;
+    while(buf == NULL)
+    {
+        for(uint i = 0; i < buffer_count; i++)
+        {
+            if(!buffer_pool[i].in_use && (buf == NULL || buffer_pool[i].capacity >= size))
+            {
+                buf = &buffer_pool[i];
+                if(buf->capacity >= size)
+                {
+                    break;
+                }
+            }
+        }
+        if(buf == NULL)
+        {
+            pthread_cond_wait(&pool_free, &pool_lock);
+        }
+    }
+    buf->in_use = 1;
+    pthread_mutex_unlock(&pool_lock);
+
+    if(buf->capacity < size)
+    {
+        char *data = realloc(buf->data, size);
+        if(data == NULL)
+        {
+            printf("ERROR: Unable to allocate %ld bytes for daemon buffer\n", size);
+            pool_release(buf);
+            return NULL;
+        }
+        buf->data = data;
+        buf->capacity = size;
+    }
+    return buf;
+}
+
+//to read whole client file into a pool buffer, size gets file size
+static DaemonBuffer *read_input(int fd, long *size)
+{
+    struct stat st;
+    if(fstat(fd, &st) < 0 || st.st_size == 0)
+    {
+        return NULL;
+    }
+    *size = st.st_size;
+    DaemonBuffer *buf = pool_acquire(st.st_size);
+    if(buf == NULL)
+    {
+        return NULL;
+    }
+    long done = 0;
+    while(done < *size)
+    {
+        ssize_t n = pread(fd, buf->data + done, *size - done, done);
+        if(n <= 0)
+        {
+            printf("ERROR: Client file shrank or could not be read\n");   //truncated while request runs
+            pool_release(buf);
+            return NULL;
+        }
+        done += n;
+    }
+    return buf;
+}
+
+//to write buffer to client file from offset 0
+static Status write_output(int fd, const char *data, long size)
+{
+    if(ftruncate(fd, size) < 0)
+    {
+        return e_failure;
+    }
+    long done = 0;
+    while(done < size)
+    {
+        ssize_t n = pwrite(fd, data + done, size - done, done);
+        if(n <= 0)
+        {
+            return e_failure;
+        }
+        done += n;
+    }
+    return e_success;
+}
+
+//to encode request, fds: image, secret, stego image
+static Status daemon_encode(DaemonRequest *req, int *fds)
+{
+    long size;
+    DaemonBuffer *src = read_input(fds[0], &size);
+    if(src == NULL)
+    {
+        return e_failure;
+    }
+    //stego image has the same size as the source image
+    DaemonBuffer *dest = pool_acquire(size);
+    if(dest == NULL)
+    {
+        pool_release(src);
+        return e_failure;
+    }
+
+    EncodeInfo encInfo;
+    memset(&encInfo, 0, sizeof(encInfo));
+    encInfo.src_image_fname = "<client image>";
+    encInfo.secret_fname = "<client secret>";
+    encInfo.stego_image_fname = "<client stego image>";
+    strcpy(encInfo.extn_secret_file, req->extn_secret_file);
+
+    //same option checks as command line
+    StegoOptions opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.password = req->password[0] ? req->password : NULL;
+    opts.ecc = (req->flags & STEGO_FLAG_ECC) ? 1 : 0;
+    opts.chunk_size = (req->flags & STEGO_FLAG_CHUNKED) ? req->chunk_size : 0;
+    opts.matrix_k = (req->flags & STEGO_FLAG_MATRIX) ? req->matrix_k : 0;
+    if(set_encode_options(&encInfo, &opts) == e_failure)
+    {
+        pool_release(dest);
+        pool_release(src);
+        return e_failure;
+    }
+
+    encInfo.fptr_src_image = fmemopen(src->data, size, "r");
+    encInfo.fptr_secret = fdopen(dup(fds[1]), "r");
+    encInfo.fptr_stego_image = fmemopen(dest->data, size, "r+");   //r+ writes in place, no truncation
+
+    Status status = e_failure;
+    if(encInfo.fptr_src_image != NULL && encInfo.fptr_secret != NULL && encInfo.fptr_stego_image != NULL)
+    {
+        status = encode_open_files(&encInfo);
+    }
+    //streams are closed by encoding only on success
+    if(encInfo.fptr_src_image != NULL)
+    {
+        fclose(encInfo.fptr_src_image);
+    }
+    if(encInfo.fptr_stego_image != NULL)
+    {
+        fclose(encInfo.fptr_stego_image);
+    }
+    if(encInfo.fptr_secret != NULL)
+    {
+        fclose(encInfo.fptr_secret);
+    }
+    if(status == e_success)
+    {
+        status = write_output(fds[2], dest->data, size);
+    }
+    pool_release(dest);
+    pool_release(src);
+    return status;
+}
+
+//to decode request, fds: stego image, output secret
+static Status daemon_decode(DaemonRequest *req, int *fds, DaemonResponse *resp)
+{
+    long size;
+    DaemonBuffer *src = read_input(fds[0], &size);
+    if(src == NULL)
+    {
+        return e_failure;
+    }
+
+    DecodeInfo decInfo;
+    memset(&decInfo, 0, sizeof(decInfo));
+    decInfo.stego_image_fname = "<client stego image>";
+    decInfo.password = req->password[0] ? req->password : NULL;
+    decInfo.fptr_stego_image = fmemopen(src->data, size, "r");
+    decInfo.fptr_output_secret = fdopen(dup(fds[1]), "w");
+
+    Status status = e_failure;
+    if(decInfo.fptr_stego_image != NULL && decInfo.fptr_output_secret != NULL)
+    {
+        status = decode_open_file(&decInfo);
+    }
+    //files are closed by decoding only when data was decoded
+    if(decInfo.fptr_stego_image != NULL)
+    {
+        fclose(decInfo.fptr_stego_image);
+    }
+    if(decInfo.fptr_output_secret != NULL)
+    {
+        fclose(decInfo.fptr_output_secret);
+    }
+    pool_release(src);
+
+    strcpy(resp->secret_extn, decInfo.secret_extn);
+    resp->secret_file_size = decInfo.secret_file_size;
+    return status;
+}
+
+//to serve one client connection
+static void daemon_handle(int conn)
+{
+    DaemonRequest req;
+    DaemonResponse resp;
+    int fds[3];
+    int nfds;
+    memset(&resp, 0, sizeof(resp));
+    resp.status = e_failure;
+
+    //idle or slow clients must not pin a worker
+    struct timeval timeout = {DAEMON_IO_TIMEOUT, 0};
+    setsockopt(conn, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(conn, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    if(recv_with_fds(conn, &req, sizeof(req), fds, &nfds) == e_failure)
+    {
+        //idle for DAEMON_IO_TIMEOUT seconds, closed early or short message
+        printf("INFO: Closing client without a complete request\n");
+        for(int i = 0; i < nfds; i++)
+        {
+            close(fds[i]);
+        }
+        close(conn);
+        return;
+    }
+    else
+    {
+        req.password[DAEMON_PASSWORD_SIZE - 1] = '\0';
+        req.extn_secret_file[sizeof(req.extn_secret_file) - 1] = '\0';
+        if(req.op_type == e_encode && nfds == 3)
+        {
+            resp.status = daemon_encode(&req, fds);
+        }
+        else if(req.op_type == e_decode && nfds == 2)
+        {
+            resp.status = daemon_decode(&req, fds, &resp);
+        }
+        else
+        {
+            printf("ERROR: Invalid daemon request\n");
+        }
+    }
+    for(int i = 0; i < nfds; i++)
+    {
+        close(fds[i]);
+    }
+    if(send(conn, &resp, sizeof(resp), MSG_NOSIGNAL) != sizeof(resp))
+    {
+        printf("ERROR: Unable to send daemon response\n");
+    }
+    close(conn);
+}
+
+static void *daemon_worker(void *arg)
+{
+    (void)arg;
+    while(1)
+    {
+        pthread_mutex_lock(&conn_lock);
+        while(conn_count == 0)
+        {
+            pthread_cond_wait(&conn_ready, &conn_lock);
+        }
+        int conn = conn_queue[conn_head];
+        conn_head = (conn_head + 1) % DAEMON_QUEUE_SIZE;
+        conn_count--;
+        pthread_cond_signal(&conn_space);
+        pthread_mutex_unlock(&conn_lock);
+
+        daemon_handle(conn);
+    }
+    return NULL;
+}
+
+//to fill unix socket address, e_failure if path is too long
+static Status daemon_address(const char *socket_path, struct sockaddr_un *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if(strlen(socket_path) >= sizeof(addr->sun_path))
+    {
+        printf("ERROR: Socket path %s is too long\n", socket_path);
+        return e_failure;
+    }
+    strcpy(addr->sun_path, socket_path);
+    return e_success;
+}
+
+/*
+ * Run daemon
+ * Input: unix socket path, options (-t worker threads)
+ * Description: accepts connections and queues them for worker
+ * threads, returns only on socket errors
+ */
+Status do_daemon(const char *socket_path, const StegoOptions *opts)
+{
+    struct sockaddr_un addr;
+    if(daemon_address(socket_path, &addr) == e_failure)
+    {
+        return e_failure;
+    }
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    unlink(socket_path);   //remove socket left by previous run
+    if(sock < 0 || bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(sock, 128) < 0)
+    {
+        perror("socket");
+        fprintf(stderr, "ERROR: Unable to listen on %s\n", socket_path);
+        return e_failure;
+    }
+    signal(SIGPIPE, SIG_IGN);
+    rs_init();   //shared tables are built before workers start
+
+    uint workers = opts->threads ? opts->threads : DAEMON_DEFAULT_WORKERS;
+    buffer_count = workers * DAEMON_BUFFERS_PER_WORKER;
+    buffer_pool = calloc(buffer_count, sizeof(DaemonBuffer));
+    if(buffer_pool == NULL)
+    {
+        printf("ERROR: Unable to allocate daemon buffer pool\n");
+        return e_failure;
+    }
+    for(uint i = 0; i < workers; i++)
+    {
+        pthread_t thread;
+        if(pthread_create(&thread, NULL, daemon_worker, NULL) != 0)
+        {
+            printf("ERROR: Unable to start worker thread\n");
+            return e_failure;
+        }
+        pthread_detach(thread);
+    }
+    printf("INFO: ## Daemon Listening on %s with %u Workers ##\n", socket_path, workers);
+    fflush(stdout);
+
+    while(1)
+    {
+        int conn = accept4(sock, NULL, NULL, SOCK_CLOEXEC);
+        if(conn < 0)
+        {
+            perror("accept");
+            continue;
+        }
+        pthread_mutex_lock(&conn_lock);
+        while(conn_count == DAEMON_QUEUE_SIZE)
+        {
+            pthread_cond_wait(&conn_space, &conn_lock);
+        }
+        conn_queue[(conn_head + conn_count) % DAEMON_QUEUE_SIZE] = conn;
+        conn_count++;
+        pthread_cond_signal(&conn_ready);
+        pthread_mutex_unlock(&conn_lock);
+    }
+    return e_success;
+}
+
+//to send request to daemon and wait for response
+static Status daemon_call(const char *socket_path, DaemonRequest *req, int *fds, int nfds, DaemonResponse *resp)
+{
+    struct sockaddr_un addr;
+    if(daemon_address(socket_path, &addr) == e_failure)
+    {
+        return e_failure;
+    }
+    int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(sock < 0 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("connect");
+        fprintf(stderr, "ERROR: Unable to connect to daemon on %s\n", socket_path);
+        if(sock >= 0)
+        {
+            close(sock);
+        }
+        return e_failure;
+    }
+    Status status = send_with_fds(sock, req, sizeof(*req), fds, nfds);
+    if(status == e_success && recv(sock, resp, sizeof(*resp), MSG_WAITALL) != sizeof(*resp))
+    {
+        status = e_failure;
+    }
+    close(sock);
+    if(status == e_failure)
+    {
+        printf("ERROR: No response from daemon\n");
+    }
+    return status;
+}
+
+//to fill common request fields from options
+static Status daemon_fill_request(DaemonRequest *req, int op_type, const StegoOptions *opts)
+{
+    memset(req, 0, sizeof(*req));
+    req->op_type = op_type;
+    if(opts->password != NULL)
+    {
+        if(strlen(opts->password) >= DAEMON_PASSWORD_SIZE)
+        {
+            printf("ERROR: Password too long for daemon mode\n");
+            return e_failure;
+        }
+        strcpy(req->password, opts->password);
+    }
+    return e_success;
+}
+
+Status daemon_client_encode(char *argv[], int argc, const StegoOptions *opts)
+{
+    EncodeInfo encInfo;
+    DaemonRequest req;
+    DaemonResponse resp;
+    if(read_and_validate_encode_args(argv, &encInfo, argc) == e_failure || daemon_fill_request(&req, e_encode, opts) == e_failure)
+    {
+        return e_failure;
+    }
+    if(set_encode_options(&encInfo, opts) == e_failure)
+    {
+        return e_failure;
+    }
+    req.flags = encInfo.flags;
+    req.chunk_size = encInfo.chunk_size;
+    req.matrix_k = encInfo.matrix_k;
+    strcpy(req.extn_secret_file, encInfo.extn_secret_file);
+
+    int fds[3];
+    fds[0] = open(encInfo.src_image_fname, O_RDONLY);
+    fds[1] = open(encInfo.secret_fname, O_RDONLY);
+    fds[2] = open(encInfo.stego_image_fname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    Status status = e_failure;
+    if(fds[0] < 0 || fds[1] < 0 || fds[2] < 0)
+    {
+        perror("open");
+        fprintf(stderr, "ERROR: Unable to open files for daemon request\n");
+    }
+    else if(daemon_call(opts->socket_path, &req, fds, 3, &resp) == e_success)
+    {
+        status = resp.status;
+    }
+    for(int i = 0; i < 3; i++)
+    {
+        if(fds[i] >= 0)
+        {
+            close(fds[i]);
+        }
+    }
+    if(status == e_success)
+    {
+        printf("INFO: ## Encoding Done Successfully by Daemon ##\n");
+    }
+    else
+    {
+        printf("ERROR: Daemon failed to encode %s\n", encInfo.src_image_fname);
+    }
+    return status;
+}
+
+Status daemon_client_decode(char *argv[], int argc, const StegoOptions *opts)
+{
+    DecodeInfo decInfo;
+    DaemonRequest req;
+    DaemonResponse resp;
+    if(read_and_validate_decode_args(argv, &decInfo, argc) == e_failure || daemon_fill_request(&req, e_decode, opts) == e_failure)
+    {
+        return e_failure;
+    }
+
+    //secret is written to shared memory first, its name needs the decoded extension
+    int fds[2];
+    fds[0] = open(decInfo.stego_image_fname, O_RDONLY);
+    fds[1] = memfd_create("stego_secret", MFD_CLOEXEC);
+    Status status = e_failure;
+    if(fds[0] < 0 || fds[1] < 0)
+    {
+        perror("open");
+        fprintf(stderr, "ERROR: Unable to open files for daemon request\n");
+    }
+    else if(daemon_call(opts->socket_path, &req, fds, 2, &resp) == e_success && resp.status == e_success)
+    {
+        resp.secret_extn[sizeof(resp.secret_extn) - 1] = '\0';
+        strcat(decInfo.output_secret_fname, resp.secret_extn);
+        int out_fd = open(decInfo.output_secret_fname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        off_t offset = 0;
+        if(out_fd >= 0 && sendfile(out_fd, fds[1], &offset, resp.secret_file_size) == resp.secret_file_size)
+        {
+            status = e_success;
+        }
+        if(out_fd >= 0)
+        {
+            close(out_fd);
+        }
+    }
+    for(int i = 0; i < 2; i++)
+    {
+        if(fds[i] >= 0)
+        {
+            close(fds[i]);
+        }
+    }
+    if(status == e_success)
+    {
+        printf("INFO: ## Decoding Done Successfully by Daemon, Created %s ##\n", decInfo.output_secret_fname);
+    }
+    else
+    {
+        printf("ERROR: Daemon failed to decode %s\n", decInfo.stego_image_fname);
+    }
+    return status;
+}
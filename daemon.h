@@ -0,0 +1,62 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include "types.h" // Contains user defined types
+
+/* Defaults for daemon mode */
+#define DAEMON_DEFAULT_WORKERS 4
+#define DAEMON_QUEUE_SIZE 64
+#define DAEMON_PASSWORD_SIZE 64
+#define DAEMON_IO_TIMEOUT 5   //seconds a client may take to send its request or read the response
+
+/* Image buffers kept warm between requests, larger buffers are freed after use */
+#define DAEMON_BUFFERS_PER_WORKER 2
+#define DAEMON_POOL_KEEP_SIZE (64L << 20)
+
+/*
+ * Buffer of the pool, client images are read into it with pread and
+ * stego images are written from it, client fds are never mapped
+ */
+typedef struct _DaemonBuffer
+{
+    char *data;
+    long capacity;   //allocated bytes, kept between requests
+    int in_use;
+
+} DaemonBuffer;
+
+/*
+ * Request sent by client, followed by file descriptors (SCM_RIGHTS)
+ * encode: image fd, secret fd, stego image fd
+ * decode: stego image fd, output secret fd
+ * Any fd which supports pread / pwrite works, files or memfd shared memory.
+ */
+typedef struct _DaemonRequest
+{
+    int op_type;                          //e_encode or e_decode
+    uint flags;                          //STEGO_FLAG_* for encoding
+    char password[DAEMON_PASSWORD_SIZE]; //empty if not encrypted
+    char extn_secret_file[5];           //secret file extension for encoding
+    uint chunk_size;                   //chunk size when STEGO_FLAG_CHUNKED
+    uint matrix_k;                    //Hamming k when STEGO_FLAG_MATRIX
+
+} DaemonRequest;
+
+typedef struct _DaemonResponse
+{
+    int status;             //e_success or e_failure
+    char secret_extn[5];   //decoded secret file extension
+    int secret_file_size; //decoded secret file size
+
+} DaemonResponse;
+
+/* Run daemon on unix socket until killed */
+Status do_daemon(const char *socket_path, const StegoOptions *opts);
+
+/* Send encode request for validated args to daemon */
+Status daemon_client_encode(char *argv[], int argc, const StegoOptions *opts);
+
+/* Send decode request for validated args to daemon */
+Status daemon_client_decode(char *argv[], int argc, const StegoOptions *opts);
+
+#endif
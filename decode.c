@@ -31,20 +31,26 @@ Description : This project implements LSB (Least Significant Bit) based Steganog
 #include "types.h"
 #include<string.h>
 #include"common.h"
+#include"cipher.h"
+#include"rs.h"
+#include"format.h"
+#include"matrix.h"
+#include"update.h"
+#include<stdlib.h>
 
 //function definition for argument validation
 Status read_and_validate_decode_args(char *argv[], DecodeInfo *decInfo, int argc)
 {
-    //to check if argv[2] is a bmp file
-    char* ptr1 = strstr(argv[2], ".bmp");
-    if(ptr1 == NULL || strcmp(ptr1, ".bmp"))
+    //to check if argv[2] is a supported image file
+    if(format_from_fname(argv[2]) == NULL)
     {
-        printf("%s is not a bmp file\n", argv[2]);
+        printf("%s is not a %s file\n", argv[2], SUPPORTED_IMAGE_EXTNS);
         return e_failure;
     }
     else
     {
         decInfo->stego_image_fname = argv[2];
+        decInfo->profile = NULL;   //set by caller when profiling
     }
 
     //to check if secret file name is passed or not
@@ -57,6 +63,7 @@ Status read_and_validate_decode_args(char *argv[], DecodeInfo *decInfo, int argc
         printf("INFO: Output File not mentioned creating secret_op as default file name\n");
         strcpy(decInfo->output_secret_fname, "secret_op");
     }
+    decInfo->fptr_output_secret = NULL;   //opened after extension is decoded
     return e_success;
 }
 
@@ -64,20 +71,40 @@ Status read_and_validate_decode_args(char *argv[], DecodeInfo *decInfo, int argc
 Status do_decoding(DecodeInfo *decInfo)
 {
     printf("INFO: ## Decoding Procedure Started ##\n");
+    profile_stage(decInfo->profile, "open files");
     if(open_img_file(decInfo) == e_success)
     { 
-        if(skip_bmp_header(decInfo) == e_success)
+        return decode_open_file(decInfo);
+    }
+    profile_stage(decInfo->profile, NULL);
+    return e_failure;
+}
+
+//to decode using stego file ptr already set in decInfo, file can be a memory stream
+Status decode_open_file(DecodeInfo *decInfo)
+{
+    profile_stage(decInfo->profile, "image header");
+    if(skip_image_header(decInfo) == e_success)
+    {
+        profile_stage(decInfo->profile, "magic string");
+        if(decode_magic_string(decInfo) == e_success)
         {
-            if(decode_magic_string(decInfo) == e_success)
+            profile_stage(decInfo->profile, "stego flags");
+            if(decode_stego_flags(decInfo) == e_success)
             {
+                profile_stage(decInfo->profile, "extn size");
                 if(decode_secret_file_extn_size(decInfo) == e_success)
                 {
+                    profile_stage(decInfo->profile, "extn");
                     if(decode_secret_file_extn(decInfo) == e_success)
                     {
+                        profile_stage(decInfo->profile, "file size");
                         if(decode_secret_file_size(decInfo) == e_success)
                         {
+                            profile_stage(decInfo->profile, "file data");
                             if(decode_secret_file_data(decInfo) == e_success)
                             {
+                                profile_stage(decInfo->profile, NULL);
                                 printf("INFO: ## Decoding Done Successfully ##\n");
                                 return e_success;
                             }
@@ -87,6 +114,7 @@ Status do_decoding(DecodeInfo *decInfo)
             }
         }
     }
+    profile_stage(decInfo->profile, NULL);
     return e_failure;
 }
 
@@ -109,10 +137,14 @@ Status open_img_file(DecodeInfo *decInfo)
     return e_success;
 }
 
-Status skip_bmp_header(DecodeInfo *decInfo)
+Status skip_image_header(DecodeInfo *decInfo)
 {
-    //skips 54 bytes
-    if(fseek(decInfo->fptr_stego_image, 54, SEEK_SET) == 0)
+    if(read_image_info(decInfo->fptr_stego_image, &decInfo->image) == e_failure)
+    {
+        return e_failure;
+    }
+    //skips header, pixel data offset comes from format backend
+    if(fseek(decInfo->fptr_stego_image, decInfo->image.pixel_offset, SEEK_SET) == 0)
     {
         return e_success;
     }
@@ -139,6 +171,13 @@ Status decode_magic_string(DecodeInfo *decInfo)
     magic_string[2] = '\0';
     if(!strcmp(magic_string, MAGIC_STRING))
     {
+        decInfo->flags = 0;   //plain stego image, no flags field
+        printf("INFO: Done\n");
+        return e_success;
+    }
+    else if(!strcmp(magic_string, MAGIC_STRING_EXT))
+    {
+        decInfo->flags = 1;   //flags field follows, read by decode_stego_flags
         printf("INFO: Done\n");
         return e_success;
     }
@@ -149,6 +188,103 @@ Status decode_magic_string(DecodeInfo *decInfo)
 
 }
 
+//to decode flags and the header fields needed by each flag
+Status decode_stego_flags(DecodeInfo *decInfo)
+{
+    if(decInfo->flags == 0)   //plain stego image has no flags field
+    {
+        return e_success;
+    }
+
+    printf("INFO: Decoding Stego Flags\n");
+    char buffer[32];
+    if(fread(buffer, 1, 32, decInfo->fptr_stego_image) != 32)   //reads 32 bytes of data and store in buffer and check if 32 bytes is read properly.
+    {
+        printf("Error while reading\n");   //prints error message
+        return e_failure;
+    }
+    decInfo->flags = decode_int_from_lsb(buffer);
+    if(decInfo->flags & ~STEGO_FLAGS_SUPPORTED)
+    {
+        printf("ERROR: Unsupported stego flags 0x%x\n", decInfo->flags);
+        return e_failure;
+    }
+
+    if(decInfo->flags & STEGO_FLAG_CIPHER)
+    {
+        printf("INFO: Decoding Cipher Nonce and Salt\n");
+        if(decInfo->password == NULL)
+        {
+            printf("ERROR: %s is encrypted, pass the password with -k\n", decInfo->stego_image_fname);
+            return e_failure;
+        }
+        unsigned char nonce[CIPHER_NONCE_SIZE + CIPHER_SALT_SIZE];   //salt follows nonce
+        char byte_buffer[8];
+        for(int i = 0; i < CIPHER_NONCE_SIZE + CIPHER_SALT_SIZE; i++)
+        {
+            if(fread(byte_buffer, 1, 8, decInfo->fptr_stego_image) != 8)   //reads 8 bytes of data and store in buffer and check if 8 bytes is read properly.
+            {
+                printf("Error while reading\n");   //prints error message
+                return e_failure;
+            }
+            nonce[i] = decode_byte_from_lsb(byte_buffer);
+        }
+        if(cipher_init(&decInfo->cipher, decInfo->password, nonce, nonce + CIPHER_NONCE_SIZE) == e_failure)
+        {
+            return e_failure;
+        }
+    }
+
+    if(decInfo->flags & STEGO_FLAG_MATRIX)
+    {
+        printf("INFO: Decoding Matrix Embedding k\n");
+        char int_buffer[32];
+        if(fread(int_buffer, 1, 32, decInfo->fptr_stego_image) != 32)   //reads 32 bytes of data and store in buffer and check if 32 bytes is read properly.
+        {
+            printf("Error while reading\n");   //prints error message
+            return e_failure;
+        }
+        decInfo->matrix_k = decode_int_from_lsb(int_buffer);
+        if(decInfo->matrix_k < MATRIX_MIN_K || decInfo->matrix_k > MATRIX_MAX_K)
+        {
+            printf("ERROR: Invalid matrix embedding k = %u\n", decInfo->matrix_k);
+            return e_failure;
+        }
+    }
+
+    if(decInfo->flags & STEGO_FLAG_CHUNKED)
+    {
+        printf("INFO: Decoding Chunk Table\n");
+        char int_buffer[32];
+        for(int i = 0; i < 2; i++)
+        {
+            if(fread(int_buffer, 1, 32, decInfo->fptr_stego_image) != 32)   //reads 32 bytes of data and store in buffer and check if 32 bytes is read properly.
+            {
+                printf("Error while reading\n");   //prints error message
+                return e_failure;
+            }
+            if(i == 0)
+            {
+                decInfo->chunk_size = decode_int_from_lsb(int_buffer);
+            }
+            else
+            {
+                decInfo->chunk_count = decode_int_from_lsb(int_buffer);
+            }
+        }
+        if(decInfo->chunk_size == 0 || decInfo->chunk_count == 0 || (unsigned long)decInfo->chunk_size * decInfo->chunk_count * 8 > decInfo->image.pixel_size)
+        {
+            printf("ERROR: Invalid chunk table\n");
+            return e_failure;
+        }
+        //digests are only needed by -u update, skip them
+        decInfo->chunk_table_offset = ftell(decInfo->fptr_stego_image);
+        fseek(decInfo->fptr_stego_image, CHUNK_DIGEST_SIZE * 8L * decInfo->chunk_count, SEEK_CUR);
+    }
+    printf("INFO: Done\n");
+    return e_success;
+}
+
 Status decode_secret_file_extn_size(DecodeInfo *decInfo)
 {
     printf("INFO: Decoding Output File Extension Size\n");
@@ -159,6 +295,12 @@ Status decode_secret_file_extn_size(DecodeInfo *decInfo)
         return e_failure;
     }
     decInfo->secret_extn_size = decode_int_from_lsb(buffer);  //stores file extension size in buffer
+    //header fields are not RS protected, a flipped LSB must not be trusted
+    if(decInfo->secret_extn_size < 0 || decInfo->secret_extn_size >= (int)sizeof(decInfo->secret_extn))
+    {
+        printf("ERROR: Invalid secret file extension size %d\n", decInfo->secret_extn_size);
+        return e_failure;
+    }
     printf("INFO: Done\n");
     return e_success;
 }
@@ -178,10 +320,21 @@ Status decode_secret_file_extn(DecodeInfo *decInfo)
         extn[i] = decode_byte_from_lsb(buffer);   //stores extension character by character after decoding
     }
     extn[decInfo->secret_extn_size] = '\0';   //adds null character at the end
+    strcpy(decInfo->secret_extn, extn);
     strcat(decInfo->output_secret_fname, extn);   //joins extension with secret file name
     printf("INFO: Done\n");
 
-    decInfo->fptr_output_secret = fopen(decInfo->output_secret_fname, "w");   //opens secret fileto store datra in write mode
+    //output may already be opened by caller, e.g. a file descriptor passed to the daemon
+    if(decInfo->fptr_output_secret == NULL)
+    {
+        decInfo->fptr_output_secret = fopen(decInfo->output_secret_fname, "w");   //opens secret fileto store datra in write mode
+        if(decInfo->fptr_output_secret == NULL)
+        {
+            perror("fopen");
+            fprintf(stderr, "ERROR: Unable to open file %s\n", decInfo->output_secret_fname);
+            return e_failure;
+        }
+    }
     printf("INFO: Opened %s\n", decInfo->output_secret_fname);
     printf("INFO: Done, Opened all require Files\n");
     return e_success;
@@ -200,6 +353,17 @@ Status decode_secret_file_size(DecodeInfo *decInfo)
         return e_failure;
     }
     decInfo->secret_file_size = decode_int_from_lsb(buffer);  // stores decoded secret file size to buffer
+
+    //to check the payload of this size fits in the pixel bytes left, before anything is allocated for it
+    long size = decInfo->secret_file_size;
+    long payload = (decInfo->flags & STEGO_FLAG_ECC) ? (size + RS_K - 1) / RS_K * RS_N : size;
+    long needed = (decInfo->flags & STEGO_FLAG_MATRIX) ? matrix_cover_size(payload, decInfo->matrix_k) : payload * 8;
+    long available = decInfo->image.pixel_offset + (long)decInfo->image.pixel_size - ftell(decInfo->fptr_stego_image);
+    if(size < 0 || needed > available || ((decInfo->flags & STEGO_FLAG_CHUNKED) && size > (long)decInfo->chunk_size * decInfo->chunk_count))
+    {
+        printf("ERROR: Invalid secret file size %d, stego header is damaged\n", decInfo->secret_file_size);
+        return e_failure;
+    }
     printf("INFO: Done\n");
     return e_success;
 }
@@ -208,20 +372,90 @@ Status decode_secret_file_data(DecodeInfo *decInfo)
 {
 
     printf("INFO: Decoding File Data\n");
+    int data_size = decInfo->secret_file_size;
+    unsigned char *ecc_data = NULL;   //whole encoded payload, needed to correct errors
+    if(decInfo->flags & STEGO_FLAG_ECC)
+    {
+        data_size = rs_encoded_size(decInfo->secret_file_size);
+        ecc_data = malloc(data_size);
+        if(ecc_data == NULL)
+        {
+            printf("ERROR: Unable to allocate memory for RS payload\n");
+            return e_failure;
+        }
+    }
+
+    unsigned char *matrix_data = NULL;   //payload extracted from Hamming groups
+    if(decInfo->flags & STEGO_FLAG_MATRIX)
+    {
+        long cover_size = matrix_cover_size(data_size, decInfo->matrix_k);
+        unsigned char *cover = calloc(cover_size + MATRIX_COVER_PADDING, 1);
+        matrix_data = malloc(data_size + 1);
+        if(cover == NULL || matrix_data == NULL || fread(cover, 1, cover_size, decInfo->fptr_stego_image) != (size_t)cover_size)
+        {
+            printf("Error while reading\n");   //prints error message
+            free(cover);
+            free(matrix_data);
+            free(ecc_data);
+            return e_failure;
+        }
+        matrix_extract(cover, data_size, decInfo->matrix_k, matrix_data);
+        free(cover);
+    }
+
     char buffer[8];
-    for(int i = 0; i < decInfo->secret_file_size; i++)
+    for(int i = 0; i < data_size; i++)
     {
-        if(fread(buffer, 1, 8, decInfo->fptr_stego_image) != 8)   //reads 8 bytes of data and store in buffer and check if 8 bytes is read properly.
+        char ch;
+        if(matrix_data != NULL)
+        {
+            ch = matrix_data[i];
+        }
+        else if(fread(buffer, 1, 8, decInfo->fptr_stego_image) != 8)   //reads 8 bytes of data and store in buffer and check if 8 bytes is read properly.
         {
             printf("Error while reading\n");   //prints error message
+            free(ecc_data);
             return e_failure;
         }
-        fputc(decode_byte_from_lsb(buffer), decInfo->fptr_output_secret);  //stres char by char in output file
+        else
+        {
+            ch = decode_byte_from_lsb(buffer);
+        }
+        if(decInfo->flags & STEGO_FLAG_CIPHER)
+        {
+            ch ^= cipher_next_byte(&decInfo->cipher);   //decrypt while extracting, no separate pass
+        }
+        if(ecc_data != NULL)
+        {
+            ecc_data[i] = ch;
+        }
+        else
+        {
+            fputc(ch, decInfo->fptr_output_secret);  //stres char by char in output file
+        }
+    }
+
+    free(matrix_data);
+
+    Status status = e_success;
+    if(ecc_data != NULL)
+    {
+        int corrected;
+        printf("INFO: Correcting Errors\n");
+        status = rs_decode(ecc_data, decInfo->secret_file_size, &corrected);
+        printf("INFO: Corrected %d byte errors\n", corrected);
+        fwrite(ecc_data, 1, decInfo->secret_file_size, decInfo->fptr_output_secret);  //data is in order at start of payload
+        free(ecc_data);
     }
     fclose(decInfo->fptr_output_secret);
     fclose(decInfo->fptr_stego_image);
-    printf("INFO: Done\n");
-    return e_success;
+    decInfo->fptr_output_secret = NULL;
+    decInfo->fptr_stego_image = NULL;
+    if(status == e_success)
+    {
+        printf("INFO: Done\n");
+    }
+    return status;
 
 }
 
@@ -239,10 +473,16 @@ char decode_byte_from_lsb(char* buffer)
 //to decode int
 int decode_int_from_lsb(char* buffer)
 {
-    int num = 0;
+    return (int)decode_uint_from_lsb(buffer);
+}
+
+//to decode unsigned int
+uint decode_uint_from_lsb(char* buffer)
+{
+    uint num = 0;
     for(int i = 0; i < 32; i++)
     {
-        num = num | ((buffer[i] & 1) << (31-i));
+        num = num | ((uint)(buffer[i] & 1) << (31-i));
     }
     return num;
 }
\ No newline at end of file
@@ -3,11 +3,15 @@
 
 #include<stdio.h>
 #include "types.h" // Contains user defined types
+#include "cipher.h"
+#include "format.h"
+#include "profile.h"
 
 typedef struct _DecodeInfo
 {
     char *stego_image_fname;   //store encoded stego image file name
     FILE *fptr_stego_image;
+    ImageInfo image;   //format backend and pixel region of stego image
 
     //secret file
     char output_secret_fname[20];     //store output secret file name
@@ -16,18 +20,35 @@ typedef struct _DecodeInfo
     char secret_extn[5];
     int secret_file_size;
 
+    //stego header options
+    char *password;       //password for decryption, NULL if not given
+    uint flags;          //STEGO_FLAG_* bits read from stego header
+    CipherInfo cipher;  //keystream state when encrypted
+    uint chunk_size;         //payload chunk size when chunked
+    uint chunk_count;       //number of chunks reserved in stego image
+    long chunk_table_offset;   //file offset of chunk digest table
+    uint matrix_k;            //payload bits per Hamming group when matrix embedded
+
+    //profiling
+    ProfileInfo *profile;   //stage counters with -p, NULL if not profiling
+
+
 } DecodeInfo;
 
 Status read_and_validate_decode_args(char *argv[], DecodeInfo *decInfo, int argc);
 
 Status do_decoding(DecodeInfo *decInfo);
 
+Status decode_open_file(DecodeInfo *decInfo);
+
 Status open_img_file(DecodeInfo *decInfo);
 
-Status skip_bmp_header(DecodeInfo *decInfo);
+Status skip_image_header(DecodeInfo *decInfo);
 
 Status decode_magic_string(DecodeInfo *decInfo);
 
+Status decode_stego_flags(DecodeInfo *decInfo);
+
 Status decode_secret_file_extn_size(DecodeInfo *decInfo);
 
 Status decode_secret_file_extn(DecodeInfo *decInfo);
@@ -40,4 +61,6 @@ char decode_byte_from_lsb(char* buffer);
 
 int decode_int_from_lsb(char* buffer);
 
+uint decode_uint_from_lsb(char* buffer);
+
 #endif
\ No newline at end of file
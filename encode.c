@@ -31,34 +31,16 @@ Description : This project implements LSB (Least Significant Bit) based Steganog
 #include "types.h"
 #include<string.h>
 #include"common.h"
+#include"cipher.h"
+#include"rs.h"
+#include"format.h"
+#include"update.h"
+#include"matrix.h"
+#include<stdlib.h>
 
 
 /* Function Definitions */
 
-/* Get image size
- * Input: Image file ptr
- * Output: width * height * bytes per pixel (3 in our case)
- * Description: In BMP Image, width is stored in offset 18,
- * and height after that. size is 4 bytes
- */
-uint get_image_size_for_bmp(FILE *fptr_image)
-{
-    uint width, height;
-    // Seek to 18th byte
-    fseek(fptr_image, 18, SEEK_SET);
-
-    // Read the width (an int)
-    fread(&width, sizeof(int), 1, fptr_image);
-    //printf("width = %u\n", width);
-
-    // Read the height (an int)
-    fread(&height, sizeof(int), 1, fptr_image);
-    //printf("height = %u\n", height);
-
-    // Return image capacity
-    return width * height * 3;   //3 is size of pixel
-}
-
 /* 
  * Get File pointers for i/p and o/p files
  * Inputs: Src Image file, Secret file and
@@ -114,11 +96,11 @@ Status open_files(EncodeInfo *encInfo)
 Status read_and_validate_encode_args(char *argv[], EncodeInfo *encInfo, int argc)
 {
 
-    //to check if argv[2] is a bmp file
-    char* ptr1 = strstr(argv[2], ".bmp");
-    if(ptr1 == NULL || strcmp(ptr1, ".bmp"))
+    //to check if argv[2] is a supported image file
+    const ImageFormat *format = format_from_fname(argv[2]);
+    if(format == NULL)
     {
-        printf("%s is not a bmp file\n", argv[2]);
+        printf("%s is not a %s file\n", argv[2], SUPPORTED_IMAGE_EXTNS);
         return e_failure;
     }
     else
@@ -154,23 +136,23 @@ Status read_and_validate_encode_args(char *argv[], EncodeInfo *encInfo, int argc
         }
     }
 
-    //to check argv[4] passed if yes checks if it is bmp file else passes default file name to structure
+    //to check argv[4] passed if yes checks if it is same format as source else passes default file name to structure
     if(argv[4] == NULL)
     {
-        encInfo->stego_image_fname = "stego.bmp";
-        printf("INFO: Output File not mentioned creating stego.bmp as default\n");
+        sprintf(encInfo->default_stego_fname, "stego%s", format_extn(format, argv[2]));
+        encInfo->stego_image_fname = encInfo->default_stego_fname;
+        printf("INFO: Output File not mentioned creating %s as default\n", encInfo->stego_image_fname);
         return e_success;
     }
     else
     {
-        //to check if argv[4] is a bmp file
-        char* ptr5 = strstr(argv[4], ".bmp");
-        if(ptr5 == NULL || strcmp(ptr5, ".bmp"))  //if not bmp file
+        //to check if argv[4] is a file of the same format
+        if(format_from_fname(argv[4]) != format)  //if not same format
         {
-            printf("%s is not a bmp file\n", argv[4]);
+            printf("%s is not a %s file\n", argv[4], format->name);
             return e_failure;
         } 
-        else   //if is bmp file
+        else   //if is same format
         {
             encInfo->stego_image_fname = argv[4];
             return e_success;
@@ -189,33 +171,134 @@ OperationType check_operation_type(char *argv[])
     {
         return e_decode;
     }
+    else if(!strcmp(argv[1], "-b"))
+    {
+        return e_batch;
+    }
+    else if(!strcmp(argv[1], "-D"))
+    {
+        return e_daemon;
+    }
+    else if((!strcmp(argv[1], "-fe") || !strcmp(argv[1], "--stream-encode")) && argv[3] != NULL)
+    {
+        return e_stream_encode;
+    }
+    else if(!strcmp(argv[1], "-fd") || !strcmp(argv[1], "--stream-decode"))
+    {
+        return e_stream_decode;
+    }
+    else if(!strcmp(argv[1], "-C") && argv[3] != NULL)
+    {
+        return e_coordinator;
+    }
+    else if(!strcmp(argv[1], "-W"))
+    {
+        return e_worker;
+    }
+    else if(!strcmp(argv[1], "-a") || !strcmp(argv[1], "--analyze"))
+    {
+        return e_analyze;
+    }
+    else if((!strcmp(argv[1], "-u") || !strcmp(argv[1], "--update")) && argv[3] != NULL)
+    {
+        return e_update;
+    }
     else
     {
         return e_unsupported;
     }
 }
 
+//to copy command line options to encInfo
+Status set_encode_options(EncodeInfo *encInfo, const StegoOptions *opts)
+{
+    encInfo->password = opts->password;
+    encInfo->profile = NULL;   //set by caller when profiling
+    encInfo->flags = 0;
+    if(opts->password != NULL)
+    {
+        encInfo->flags |= STEGO_FLAG_CIPHER;
+    }
+    if(opts->ecc)
+    {
+        encInfo->flags |= STEGO_FLAG_ECC;
+    }
+    encInfo->chunk_size = opts->chunk_size;
+    if(opts->chunk_size)
+    {
+        //chunks are rewritten in place, a reused keystream or RS interleaving would break
+        if(encInfo->flags & (STEGO_FLAG_CIPHER | STEGO_FLAG_ECC))
+        {
+            printf("ERROR: -c can not be combined with -k or -r\n");
+            return e_failure;
+        }
+        encInfo->flags |= STEGO_FLAG_CHUNKED;
+    }
+    encInfo->matrix_k = opts->matrix_k;
+    if(opts->matrix_k)
+    {
+        if(opts->matrix_k < MATRIX_MIN_K || opts->matrix_k > MATRIX_MAX_K)
+        {
+            printf("ERROR: -m needs k from %d to %d\n", MATRIX_MIN_K, MATRIX_MAX_K);
+            return e_failure;
+        }
+        //chunks are rewritten byte aligned, groups of k bits would cross them
+        if(encInfo->flags & STEGO_FLAG_CHUNKED)
+        {
+            printf("ERROR: -m can not be combined with -c\n");
+            return e_failure;
+        }
+        encInfo->flags |= STEGO_FLAG_MATRIX;
+    }
+    return e_success;
+}
+
 //encoding function that contains all sub function calls
 Status do_encoding(EncodeInfo *encInfo)
 {
+    profile_stage(encInfo->profile, "open files");
     if(open_files(encInfo) == e_success)
     {
-        printf("INFO: ## Encoding Procedure Started ##\n");
-        if(check_capacity(encInfo) == e_success)
+        return encode_open_files(encInfo);
+    }
+    profile_stage(encInfo->profile, NULL);
+    return e_failure;
+}
+
+//to encode using file ptrs already set in encInfo, files can be memory streams
+Status encode_open_files(EncodeInfo *encInfo)
+{
+    printf("INFO: ## Encoding Procedure Started ##\n");
+    profile_stage(encInfo->profile, "check capacity");
+    if(check_capacity(encInfo) == e_success)
+    {
+        profile_stage(encInfo->profile, "image header");
+        if(copy_image_header(encInfo) == e_success)
         {
-            if(copy_bmp_header(encInfo->fptr_src_image,encInfo->fptr_stego_image) == e_success)
+            profile_stage(encInfo->profile, "magic string");
+            if(encode_magic_string(encInfo->flags ? MAGIC_STRING_EXT : MAGIC_STRING, encInfo) == e_success)
             {
-                if(encode_magic_string(MAGIC_STRING, encInfo) == e_success)
+                profile_stage(encInfo->profile, "stego flags");
+                if(encode_stego_flags(encInfo) == e_success)
                 {
+                    profile_stage(encInfo->profile, "extn size");
                     if(encode_secret_file_extn_size(strlen(encInfo->extn_secret_file), encInfo) == e_success)
                     {
+                        profile_stage(encInfo->profile, "extn");
                         if(encode_secret_file_extn(encInfo->extn_secret_file, encInfo) == e_success)
                         {
+                            profile_stage(encInfo->profile, "file size");
                             if(encode_secret_file_size(encInfo->secret_file_size, encInfo) == e_success)
                             {
+                                profile_stage(encInfo->profile, "file data");
                                 if(encode_secret_file_data(encInfo) == e_success)
                                 {
-                                    if(copy_remaining_img_data(encInfo->fptr_src_image, encInfo->fptr_stego_image) == e_success)
+                                    profile_stage(encInfo->profile, "remaining data");
+                                    Status status = copy_remaining_img_data(encInfo->fptr_src_image, encInfo->fptr_stego_image);
+                                    encInfo->fptr_src_image = NULL;     //closed by copy_remaining_img_data
+                                    encInfo->fptr_stego_image = NULL;
+                                    profile_stage(encInfo->profile, NULL);
+                                    if(status == e_success)
                                     {
                                         printf("INFO: ## Encoding Done Successfully ##\n");
                                         return e_success;
@@ -231,14 +314,20 @@ Status do_encoding(EncodeInfo *encInfo)
                 }
             }
         }
-
     }
+
+    profile_stage(encInfo->profile, NULL);
     return e_failure;
 }
 
 Status check_capacity(EncodeInfo *encInfo)
 {
-    int image_capacity = get_image_size_for_bmp(encInfo->fptr_src_image);
+    if(read_image_info(encInfo->fptr_src_image, &encInfo->image) == e_failure)
+    {
+        printf("INFO: %s is not a valid %s file\n", encInfo->src_image_fname, SUPPORTED_IMAGE_EXTNS);
+        return e_failure;
+    }
+    long image_capacity = encInfo->image.pixel_size;   //one payload bit per pixel byte
     int magic_string_len = strlen(MAGIC_STRING);
     int extension_len = strlen(encInfo->extn_secret_file);
 
@@ -251,10 +340,44 @@ Status check_capacity(EncodeInfo *encInfo)
         printf("INFO: Done. Not empty\n");
     }
 
-    int encoding_things = 54 + ((magic_string_len + 4 + extension_len + 4 + encInfo->secret_file_size) * 8);
+    int flags_len = 0;
+    if(encInfo->flags)
+    {
+        flags_len = 4;   //flags int
+        if(encInfo->flags & STEGO_FLAG_CIPHER)
+        {
+            flags_len += CIPHER_NONCE_SIZE + CIPHER_SALT_SIZE;
+        }
+        if(encInfo->flags & STEGO_FLAG_MATRIX)
+        {
+            flags_len += 4;   //k int
+        }
+    }
+
+    int data_len = encInfo->secret_file_size;
+    if(encInfo->flags & STEGO_FLAG_CHUNKED)
+    {
+        encInfo->chunk_count = (encInfo->secret_file_size + encInfo->chunk_size - 1) / encInfo->chunk_size;
+        if(encInfo->chunk_count == 0)
+        {
+            encInfo->chunk_count = 1;
+        }
+        flags_len += 4 + 4 + CHUNK_DIGEST_SIZE * encInfo->chunk_count;   //chunk size, chunk count, digest table
+        data_len = encInfo->chunk_count * encInfo->chunk_size;   //whole chunks are reserved for updates
+    }
+    if(encInfo->flags & STEGO_FLAG_ECC)
+    {
+        data_len = rs_encoded_size(encInfo->secret_file_size);   //data + padding + parity
+    }
+
+    long encoding_things = ((long)(magic_string_len + flags_len + 4 + extension_len + 4 + data_len) * 8);
+    if(encInfo->flags & STEGO_FLAG_MATRIX)
+    {
+        encoding_things += matrix_cover_size(data_len, encInfo->matrix_k) - (long)data_len * 8;   //k bits per 2^k - 1 bytes
+    }
 
     printf("INFO: Checking for %s capacity to handle %s\n", encInfo->src_image_fname, encInfo->secret_fname);
-    if(encoding_things < image_capacity)
+    if(encoding_things <= image_capacity)
     {
 
         //just  for display below prompt
@@ -269,23 +392,17 @@ Status check_capacity(EncodeInfo *encInfo)
 
 }
 
-Status copy_bmp_header(FILE *fptr_src_image, FILE *fptr_dest_image)
+Status copy_image_header(EncodeInfo *encInfo)
 {
-    printf("INFO: Copying Image Header\n");
-    fseek(fptr_src_image, 0, SEEK_SET);  //moves the file pointer offset to 0th index
-
-    char buffer[54];   //buffer to store 54 bytes of data
-    if(fread(buffer, 1, 54, fptr_src_image) != 54)   //reads 54 bytes of data and store in buffer and check if 54 bytes is read properly.
-    {
-        printf("Error while reading header\n");   //prints error message
-        return e_failure;
-    }
+    printf("INFO: Copying %s Image Header\n", encInfo->image.format->name);
+    fseek(encInfo->fptr_src_image, 0, SEEK_SET);  //moves the file pointer offset to 0th index
 
-    if(fwrite(buffer, 1, 54, fptr_dest_image) != 54)    //writes the 54 bytes to destination / stego.bmp and checks if 54 bytes are witten properly.
+    //header is written by the format backend, file ptrs are left at first pixel byte
+    if(encInfo->image.format->write_header(encInfo->fptr_src_image, encInfo->fptr_stego_image, &encInfo->image) == e_failure)
     {
-        printf("Error while writing header\n");
         return e_failure;
     }
+    fseek(encInfo->fptr_src_image, encInfo->image.pixel_offset, SEEK_SET);
     printf("INFO: Done\n");
     return e_success;   
 }
@@ -293,7 +410,7 @@ Status copy_bmp_header(FILE *fptr_src_image, FILE *fptr_dest_image)
 Status encode_magic_string(const char *magic_string, EncodeInfo *encInfo)
 {
     printf("INFO: Encode Magic String Signature\n");
-    if(encode_data_to_image(magic_string, strlen(magic_string), encInfo->fptr_src_image, encInfo->fptr_stego_image) == e_success)
+    if(encode_data_to_image(magic_string, strlen(magic_string), encInfo->fptr_src_image, encInfo->fptr_stego_image, NULL) == e_success)
     {
         printf("INFO: Done\n");
         return e_success;
@@ -304,7 +421,7 @@ Status encode_magic_string(const char *magic_string, EncodeInfo *encInfo)
     }
 }
 
-Status encode_data_to_image(const char *data, int size, FILE *fptr_src_image, FILE *fptr_stego_image)
+Status encode_data_to_image(const char *data, int size, FILE *fptr_src_image, FILE *fptr_stego_image, CipherInfo *cipher)
 {
     char buffer[8];
     for(int i = 0; i < size; i++)
@@ -314,7 +431,12 @@ Status encode_data_to_image(const char *data, int size, FILE *fptr_src_image, FI
             printf("Error while reading data\n");   //prints error message
             return e_failure;
         }
-        if(encode_byte_to_lsb(data[i], buffer) == e_success)
+        char ch = data[i];
+        if(cipher != NULL)
+        {
+            ch ^= cipher_next_byte(cipher);   //encrypt while embedding, no separate pass
+        }
+        if(encode_byte_to_lsb(ch, buffer) == e_success)
         {
             if(fwrite(buffer, 1, 8, fptr_stego_image) != 8)    //writes the 8 bytes to destination / stego.bmp and checks if 8 bytes are witten properly.
             {
@@ -326,6 +448,45 @@ Status encode_data_to_image(const char *data, int size, FILE *fptr_src_image, FI
     return e_success;
 }
 
+//to matrix embed data, whole cover region of the data is read, changed and written at once
+Status encode_matrix_data_to_image(char *data, int size, EncodeInfo *encInfo, CipherInfo *cipher)
+{
+    long cover_size = matrix_cover_size(size, encInfo->matrix_k);
+    unsigned char *cover = calloc(cover_size + MATRIX_COVER_PADDING, 1);
+    if(cover == NULL)
+    {
+        printf("ERROR: Unable to allocate memory for matrix embedding\n");
+        return e_failure;
+    }
+    if(fread(cover, 1, cover_size, encInfo->fptr_src_image) != (size_t)cover_size)
+    {
+        printf("Error while reading data\n");
+        free(cover);
+        return e_failure;
+    }
+    if(cipher != NULL)
+    {
+        for(int i = 0; i < size; i++)
+        {
+            data[i] ^= cipher_next_byte(cipher);   //groups take bits across bytes, encrypt before grouping
+        }
+    }
+
+    long changed;
+    Status status = matrix_embed((unsigned char *)data, size, encInfo->matrix_k, cover, &changed);
+    if(status == e_success && fwrite(cover, 1, cover_size, encInfo->fptr_stego_image) != (size_t)cover_size)
+    {
+        printf("Error while writing data\n");
+        status = e_failure;
+    }
+    if(status == e_success)
+    {
+        printf("INFO: Matrix embedding changed %ld of %ld cover bytes for %d payload bytes\n", changed, cover_size, size);
+    }
+    free(cover);
+    return status;
+}
+
 Status encode_byte_to_lsb(char data, char *image_buffer)
 {
     for(int i = 0; i < 8; i++)
@@ -336,14 +497,132 @@ Status encode_byte_to_lsb(char data, char *image_buffer)
 }
 
 Status encode_int_to_lsb(int data, char *image_buffer)
+{
+    return encode_uint_to_lsb((uint)data, image_buffer);   //bit 31 of a negative int is shifted as unsigned
+}
+
+Status encode_uint_to_lsb(uint data, char *image_buffer)
 {
     for(int i = 0; i < 32; i++)
     {
-        image_buffer[i] = (image_buffer[i] & (~1)) | ((data & (1 << (31 - i))) >> (31 - i));  //encode each bits of data to 32 bytes of image buffer.
+        image_buffer[i] = (image_buffer[i] & (~1)) | ((data >> (31 - i)) & 1);  //encode each bits of data to 32 bytes of image buffer.
+    }
+    return e_success;
+}
+
+//to encode flags and the header fields needed by each flag
+Status encode_stego_flags(EncodeInfo *encInfo)
+{
+    if(encInfo->flags == 0)   //plain stego image has no flags field
+    {
+        return e_success;
+    }
+
+    printf("INFO: Encoding Stego Flags\n");
+    char buffer[32];
+    if(fread(buffer, 1, 32, encInfo->fptr_src_image) != 32)   //reads 32 bytes of data and store in buffer and check if 32 bytes is read properly.
+    {
+        printf("Error while reading data for encoding stego flags\n");   //prints error message
+        return e_failure;
+    }
+    encode_int_to_lsb(encInfo->flags, buffer);
+    if(fwrite(buffer, 1, 32, encInfo->fptr_stego_image) != 32)    //writes the 32 bytes to destination / stego.bmp and checks if 32 bytes are witten properly.
+    {
+        printf("Error while writing data for encoding stego flags\n");
+        return e_failure;
+    }
+
+    if(encInfo->flags & STEGO_FLAG_CIPHER)
+    {
+        printf("INFO: Encoding Cipher Nonce and Salt\n");
+        unsigned char nonce[CIPHER_NONCE_SIZE];
+        unsigned char salt[CIPHER_SALT_SIZE];
+        if(cipher_generate_nonce(nonce, salt) == e_failure || cipher_init(&encInfo->cipher, encInfo->password, nonce, salt) == e_failure)
+        {
+            return e_failure;
+        }
+        if(encode_data_to_image((const char *)nonce, CIPHER_NONCE_SIZE, encInfo->fptr_src_image, encInfo->fptr_stego_image, NULL) == e_failure)
+        {
+            return e_failure;
+        }
+        if(encode_data_to_image((const char *)salt, CIPHER_SALT_SIZE, encInfo->fptr_src_image, encInfo->fptr_stego_image, NULL) == e_failure)
+        {
+            return e_failure;
+        }
+    }
+
+    if(encInfo->flags & STEGO_FLAG_MATRIX)
+    {
+        printf("INFO: Encoding Matrix Embedding k = %u\n", encInfo->matrix_k);
+        if(encode_int_to_image(encInfo->matrix_k, encInfo->fptr_src_image, encInfo->fptr_stego_image) == e_failure)
+        {
+            return e_failure;
+        }
+    }
+
+    if(encInfo->flags & STEGO_FLAG_CHUNKED)
+    {
+        printf("INFO: Encoding %u Chunk Digests\n", encInfo->chunk_count);
+        if(encode_chunk_table(encInfo) == e_failure)
+        {
+            return e_failure;
+        }
+    }
+    printf("INFO: Done\n");
+    return e_success;
+}
+
+//to encode an int into next 32 image bytes
+Status encode_int_to_image(int data, FILE *fptr_src_image, FILE *fptr_stego_image)
+{
+    return encode_uint_to_image((uint)data, fptr_src_image, fptr_stego_image);
+}
+
+//to encode an unsigned int into next 32 image bytes
+Status encode_uint_to_image(uint data, FILE *fptr_src_image, FILE *fptr_stego_image)
+{
+    char buffer[32];
+    if(fread(buffer, 1, 32, fptr_src_image) != 32)   //reads 32 bytes of data and store in buffer and check if 32 bytes is read properly.
+    {
+        printf("Error while reading data\n");   //prints error message
+        return e_failure;
+    }
+    encode_uint_to_lsb(data, buffer);
+    if(fwrite(buffer, 1, 32, fptr_stego_image) != 32)    //writes the 32 bytes to destination / stego.bmp and checks if 32 bytes are witten properly.
+    {
+        printf("Error while writing data\n");
+        return e_failure;
     }
     return e_success;
 }
 
+//to encode chunk size, chunk count and digest of each chunk of secret file
+Status encode_chunk_table(EncodeInfo *encInfo)
+{
+    if(encode_int_to_image(encInfo->chunk_size, encInfo->fptr_src_image, encInfo->fptr_stego_image) == e_failure || encode_int_to_image(encInfo->chunk_count, encInfo->fptr_src_image, encInfo->fptr_stego_image) == e_failure)
+    {
+        return e_failure;
+    }
+
+    char *chunk = malloc(encInfo->chunk_size);
+    if(chunk == NULL)
+    {
+        printf("ERROR: Unable to allocate memory for chunk\n");
+        return e_failure;
+    }
+    Status status = e_success;
+    for(uint i = 0; i < encInfo->chunk_count && status == e_success; i++)
+    {
+        size_t len = fread(chunk, 1, encInfo->chunk_size, encInfo->fptr_secret);
+        unsigned char digest[CHUNK_DIGEST_SIZE];
+        chunk_digest(chunk, len, digest);
+        status = encode_data_to_image((const char *)digest, CHUNK_DIGEST_SIZE, encInfo->fptr_src_image, encInfo->fptr_stego_image, NULL);
+    }
+    free(chunk);
+    fseek(encInfo->fptr_secret, 0, SEEK_SET);   //secret data is read again for encoding
+    return status;
+}
+
 Status encode_secret_file_extn_size(int size, EncodeInfo *encInfo)
 {
     printf("INFO: Encoding %s File extension size\n", encInfo->secret_fname);
@@ -368,7 +647,7 @@ Status encode_secret_file_extn_size(int size, EncodeInfo *encInfo)
 Status encode_secret_file_extn(const char *file_extn, EncodeInfo *encInfo)
 {
     printf("INFO: Encoding %s File extension\n", encInfo->secret_fname);
-    if(encode_data_to_image(file_extn, strlen(file_extn), encInfo->fptr_src_image, encInfo->fptr_stego_image) == e_success)  //function call for encoding file extn data
+    if(encode_data_to_image(file_extn, strlen(file_extn), encInfo->fptr_src_image, encInfo->fptr_stego_image, NULL) == e_success)  //function call for encoding file extn data
     {
         printf("INFO: Done\n");
         return e_success;
@@ -411,25 +690,57 @@ Status encode_secret_file_data(EncodeInfo *encInfo)
         printf("Error while reading secret file data\n");   //prints error message
         return e_failure;
     }
-    if(encode_data_to_image(secret_file_data, encInfo->secret_file_size, encInfo->fptr_src_image, encInfo->fptr_stego_image) == e_success)  //function call for encoding file extn data
+
+    char *data = secret_file_data;
+    int data_size = encInfo->secret_file_size;
+    char *ecc_data = NULL;
+    if(encInfo->flags & STEGO_FLAG_ECC)
     {
-        printf("INFO: Done\n");
-        return e_success;
+        printf("INFO: Adding Reed-Solomon Parity\n");
+        data_size = rs_encoded_size(encInfo->secret_file_size);
+        ecc_data = malloc(data_size);
+        if(ecc_data == NULL || rs_encode((unsigned char *)secret_file_data, encInfo->secret_file_size, (unsigned char *)ecc_data) == e_failure)
+        {
+            printf("Error while adding parity to secret file data\n");
+            free(ecc_data);
+            return e_failure;
+        }
+        data = ecc_data;
+    }
+
+    CipherInfo *cipher = (encInfo->flags & STEGO_FLAG_CIPHER) ? &encInfo->cipher : NULL;
+    Status status;
+    if(encInfo->flags & STEGO_FLAG_MATRIX)
+    {
+        status = encode_matrix_data_to_image(data, data_size, encInfo, cipher);
     }
     else
     {
-        return e_failure;
+        status = encode_data_to_image(data, data_size, encInfo->fptr_src_image, encInfo->fptr_stego_image, cipher);  //function call for encoding file data
     }
+    free(ecc_data);
+    if(status == e_success)
+    {
+        printf("INFO: Done\n");
+    }
+    return status;
 }
 
 //to copy remaining data
 Status copy_remaining_img_data(FILE *fptr_src, FILE *fptr_dest)
 {
     printf("INFO: Copying Left Over Data\n");
-    char ch;
-    while (fread(&ch, 1, 1, fptr_src) == 1) 
+    char buffer[4096];   //copy in blocks, byte wise copy dominates encoding time
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), fptr_src)) > 0) 
     {
-        fwrite(&ch, 1, 1, fptr_dest);
+        if(fwrite(buffer, 1, n, fptr_dest) != n)
+        {
+            printf("Error while copying left over data\n");
+            fclose(fptr_src);
+            fclose(fptr_dest);
+            return e_failure;
+        }
     }
 
     fclose(fptr_src); //close sample.mp3
@@ -2,6 +2,9 @@
 #define ENCODE_H
 
 #include "types.h" // Contains user defined types
+#include "cipher.h"
+#include "format.h"
+#include "profile.h"
 
 /* 
  * Structure to store information required for
@@ -16,7 +19,7 @@ typedef struct _EncodeInfo
     /* Source Image info */
     char *src_image_fname;   //store source image file name
     FILE *fptr_src_image;   //file ptr for src image
-    uint image_capacity;   //store src image size
+    ImageInfo image;      //format backend and pixel region of src image
 
     /* Secret File Info */
     char *secret_fname;          //store secret filename
@@ -28,6 +31,18 @@ typedef struct _EncodeInfo
     /* Stego Image Info */
     char *stego_image_fname;   //store the output image file name
     FILE *fptr_stego_image;   //ptr for output image
+    char default_stego_fname[12];   //stego.<src extn> when output not given
+
+    /* Stego header options */
+    char *password;       //password for encryption, NULL if not encrypted
+    uint flags;          //STEGO_FLAG_* bits, 0 for plain stego image
+    CipherInfo cipher;  //keystream state when encrypted
+    uint chunk_size;    //payload chunk size when chunked
+    uint chunk_count;  //number of chunks reserved in stego image
+    uint matrix_k;    //payload bits per Hamming group when matrix embedded
+
+    /* Profiling */
+    ProfileInfo *profile;   //stage counters with -p, NULL if not profiling
 
 } EncodeInfo;
 
@@ -40,27 +55,42 @@ OperationType check_operation_type(char *argv[]);
 /* Read and validate Encode args from argv */
 Status read_and_validate_encode_args(char *argv[], EncodeInfo *encInfo, int argc);
 
+/* Copy command line options to encInfo */
+Status set_encode_options(EncodeInfo *encInfo, const StegoOptions *opts);
+
 /* Perform the encoding */
 Status do_encoding(EncodeInfo *encInfo);
 
+/* Perform the encoding on files already opened in encInfo */
+Status encode_open_files(EncodeInfo *encInfo);
+
 /* Get File pointers for i/p and o/p files */
 Status open_files(EncodeInfo *encInfo);
 
 /* check capacity */
 Status check_capacity(EncodeInfo *encInfo);
 
-/* Get image size */
-uint get_image_size_for_bmp(FILE *fptr_image);
-
 /* Get file size */
 uint get_file_size(FILE *fptr);
 
-/* Copy bmp image header */
-Status copy_bmp_header(FILE *fptr_src_image, FILE *fptr_dest_image);
+/* Copy image header using format backend */
+Status copy_image_header(EncodeInfo *encInfo);
 
 /* Store Magic String */
 Status encode_magic_string(const char *magic_string, EncodeInfo *encInfo);
 
+/* Encode stego flags and flag specific header fields */
+Status encode_stego_flags(EncodeInfo *encInfo);
+
+/* Encode chunk size, count and chunk digests */
+Status encode_chunk_table(EncodeInfo *encInfo);
+
+/* Encode an int into next 32 image bytes */
+Status encode_int_to_image(int data, FILE *fptr_src_image, FILE *fptr_stego_image);
+
+/* Encode an unsigned int into next 32 image bytes */
+Status encode_uint_to_image(uint data, FILE *fptr_src_image, FILE *fptr_stego_image);
+
 /* Encode secret file extenstion size */
 Status encode_secret_file_extn_size(int size, EncodeInfo *encInfo);
 
@@ -73,8 +103,11 @@ Status encode_secret_file_size(long file_size, EncodeInfo *encInfo);
 /* Encode secret file data*/
 Status encode_secret_file_data(EncodeInfo *encInfo);
 
-/* Encode function, which does the real encoding */
-Status encode_data_to_image(const char *data, int size, FILE *fptr_src_image, FILE *fptr_stego_image);
+/* Encode function, which does the real encoding, cipher is NULL for plain data */
+Status encode_data_to_image(const char *data, int size, FILE *fptr_src_image, FILE *fptr_stego_image, CipherInfo *cipher);
+
+/* Matrix embed secret data into next image bytes, cipher is NULL for plain data */
+Status encode_matrix_data_to_image(char *data, int size, EncodeInfo *encInfo, CipherInfo *cipher);
 
 /* Encode a byte into LSB of image data array */
 Status encode_byte_to_lsb(char data, char *image_buffer);
@@ -82,6 +115,9 @@ Status encode_byte_to_lsb(char data, char *image_buffer);
 /* Encode a int into LSB of image data array */
 Status encode_int_to_lsb(int data, char *image_buffer);
 
+/* Encode an unsigned int into LSB of image data array */
+Status encode_uint_to_lsb(uint data, char *image_buffer);
+
 /* Copy remaining image bytes from src to stego image after encoding */
 Status copy_remaining_img_data(FILE *fptr_src, FILE *fptr_dest);
 
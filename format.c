@@ -0,0 +1,322 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Cover format backends. Each backend probes the file content,
+              parses its header into an ImageInfo (where the pixel bytes start
+              and how many there are) and writes the stego image header.
+
+              Supported:
+              1. BMP, uncompressed 24 / 32 bit
+              2. PPM (P6) and PGM (P5) binary, maxval up to 255
+              3. TGA, uncompressed 24 / 32 bit true color (type 2) and
+                 8 bit grayscale (type 3)
+
+              The LSB engine in encode.c / decode.c works directly on the
+              native pixel bytes, so no conversion to BMP is needed.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <ctype.h>
+#include "format.h"
+#include "types.h"
+
+//to read little endian values from header buffer
+static uint get_le16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint get_le32(const unsigned char *p)
+{
+    return (uint)p[0] | ((uint)p[1] << 8) | ((uint)p[2] << 16) | ((uint)p[3] << 24);
+}
+
+/*
+ * Set pixel region size from width, height and channels
+ * Input: image with width, height, channels set, format name, row alignment (power of 2)
+ * Output: pixel_size, computed in 64 bit so crafted headers can not wrap it
+ * Return Value: e_failure for empty images or more than UINT_MAX pixel bytes
+ */
+static Status set_pixel_size(ImageInfo *image, const char *name, uint row_align)
+{
+    if(image->width == 0 || image->height == 0)
+    {
+        printf("ERROR: %s image has zero width or height\n", name);
+        return e_failure;
+    }
+    uint64_t stride = ((uint64_t)image->width * image->channels + row_align - 1) & ~(uint64_t)(row_align - 1);
+    if(stride > UINT_MAX || stride * image->height > UINT_MAX)
+    {
+        printf("ERROR: %s image of %u x %u pixels is too large\n", name, image->width, image->height);
+        return e_failure;
+    }
+    image->pixel_size = stride * image->height;
+    return e_success;
+}
+
+/* BMP backend */
+
+static Status bmp_probe(FILE *fptr)
+{
+    char sign[2];
+    if(fread(sign, 1, 2, fptr) == 2 && sign[0] == 'B' && sign[1] == 'M')
+    {
+        return e_success;
+    }
+    return e_failure;
+}
+
+/* Parse BMP header
+ * Description: pixel data offset is stored at offset 10, width at 18,
+ * height at 22 (negative for top down images), bits per pixel at 28
+ * and compression at 30. Rows are padded to 4 bytes.
+ */
+static Status bmp_parse_header(FILE *fptr, ImageInfo *image)
+{
+    unsigned char header[54];
+    if(fread(header, 1, 54, fptr) != 54)
+    {
+        printf("ERROR: BMP header too short\n");
+        return e_failure;
+    }
+    int height = (int)get_le32(header + 22);
+    uint bpp = get_le16(header + 28);
+    uint compression = get_le32(header + 30);
+    if((bpp != 24 && bpp != 32) || (compression != 0 && compression != 3))
+    {
+        printf("ERROR: Only uncompressed 24/32 bit BMP is supported\n");
+        return e_failure;
+    }
+
+    image->width = get_le32(header + 18);
+    image->height = (height < 0) ? (uint)(-(long)height) : (uint)height;
+    image->channels = bpp / 8;
+    image->pixel_offset = get_le32(header + 10);
+    if(image->pixel_offset < 54)
+    {
+        printf("ERROR: BMP pixel data offset %ld is inside the header\n", image->pixel_offset);
+        return e_failure;
+    }
+    return set_pixel_size(image, "BMP", 4);   //rows are padded to 4 bytes
+}
+
+/* PPM / PGM backend */
+
+static Status pnm_probe(FILE *fptr)
+{
+    char sign[2];
+    if(fread(sign, 1, 2, fptr) == 2 && sign[0] == 'P' && (sign[1] == '6' || sign[1] == '5'))
+    {
+        return e_success;
+    }
+    return e_failure;
+}
+
+//to read next header number, skipping white space and # comments
+static int pnm_read_number(FILE *fptr, uint *value)
+{
+    int ch = fgetc(fptr);
+    while(ch != EOF && (isspace(ch) || ch == '#'))
+    {
+        if(ch == '#')
+        {
+            while(ch != EOF && ch != '\n')
+            {
+                ch = fgetc(fptr);
+            }
+        }
+        ch = fgetc(fptr);
+    }
+    if(!isdigit(ch))
+    {
+        return 0;
+    }
+    *value = 0;
+    while(isdigit(ch))
+    {
+        if(*value > (UINT_MAX - 9) / 10)
+        {
+            return 0;   //too large for header field
+        }
+        *value = *value * 10 + (ch - '0');
+        ch = fgetc(fptr);
+    }
+    //single white space after maxval separates header and pixels
+    return isspace(ch) ? 1 : 0;
+}
+
+static Status pnm_parse_header(FILE *fptr, ImageInfo *image)
+{
+    char sign[2];
+    uint maxval;
+    if(fread(sign, 1, 2, fptr) != 2 || !pnm_read_number(fptr, &image->width) || !pnm_read_number(fptr, &image->height) || !pnm_read_number(fptr, &maxval))
+    {
+        printf("ERROR: Invalid PPM/PGM header\n");
+        return e_failure;
+    }
+    if(maxval == 0 || maxval > 255)
+    {
+        printf("ERROR: Only 8 bit PPM/PGM is supported\n");
+        return e_failure;
+    }
+    image->channels = (sign[1] == '6') ? 3 : 1;
+    image->pixel_offset = ftell(fptr);
+    return set_pixel_size(image, "PPM/PGM", 1);
+}
+
+/* TGA backend, TGA has no signature so header fields are sanity checked */
+
+static Status tga_read_header(FILE *fptr, unsigned char *header)
+{
+    if(fread(header, 1, 18, fptr) != 18)
+    {
+        return e_failure;
+    }
+    uint cmap_type = header[1];
+    uint image_type = header[2];
+    uint bpp = header[16];
+    if(cmap_type > 1 || get_le16(header + 12) == 0 || get_le16(header + 14) == 0)
+    {
+        return e_failure;
+    }
+    if(image_type == 2 && (bpp == 15 || bpp == 16 || bpp == 24 || bpp == 32))
+    {
+        return e_success;   //15 / 16 bit is recognised here and rejected by parse_header
+    }
+    if(image_type == 3 && bpp == 8)
+    {
+        return e_success;
+    }
+    return e_failure;
+}
+
+static Status tga_probe(FILE *fptr)
+{
+    unsigned char header[18];
+    return tga_read_header(fptr, header);
+}
+
+static Status tga_parse_header(FILE *fptr, ImageInfo *image)
+{
+    unsigned char header[18];
+    if(tga_read_header(fptr, header) == e_failure)
+    {
+        printf("ERROR: Only uncompressed true color / grayscale TGA is supported\n");
+        return e_failure;
+    }
+    //A1R5G5B5 packs green across both bytes, LSB of a byte is not a channel LSB
+    if(header[16] != 24 && header[16] != 32 && header[16] != 8)
+    {
+        printf("ERROR: Unsupported TGA depth %u bit, only 24/32 bit true color and 8 bit grayscale\n", header[16]);
+        return e_failure;
+    }
+    uint cmap_length = (header[1] == 1) ? get_le16(header + 5) * ((header[7] + 7) / 8) : 0;
+
+    image->width = get_le16(header + 12);
+    image->height = get_le16(header + 14);
+    image->channels = header[16] / 8;
+    image->pixel_offset = 18 + header[0] + cmap_length;   //header, image id, color map
+    return set_pixel_size(image, "TGA", 1);
+}
+
+/* Common header writer, LSB embedding does not change geometry so header is kept as is */
+Status copy_raw_header(FILE *fptr_src, FILE *fptr_dest, const ImageInfo *image)
+{
+    char buffer[1024];
+    long left = image->pixel_offset;
+    while(left > 0)
+    {
+        size_t n = (left < (long)sizeof(buffer)) ? (size_t)left : sizeof(buffer);
+        if(fread(buffer, 1, n, fptr_src) != n)
+        {
+            printf("Error while reading header\n");
+            return e_failure;
+        }
+        if(fwrite(buffer, 1, n, fptr_dest) != n)
+        {
+            printf("Error while writing header\n");
+            return e_failure;
+        }
+        left -= n;
+    }
+    return e_success;
+}
+
+static const ImageFormat formats[] =
+{
+    {"BMP", {".bmp", NULL}, bmp_probe, bmp_parse_header, copy_raw_header},
+    {"PPM/PGM", {".ppm", ".pgm", NULL}, pnm_probe, pnm_parse_header, copy_raw_header},
+    {"TGA", {".tga", NULL}, tga_probe, tga_parse_header, copy_raw_header},
+};
+
+#define FORMAT_COUNT (sizeof(formats) / sizeof(formats[0]))
+
+const char *format_extn(const ImageFormat *format, const char *fname)
+{
+    const char *dot = strrchr(fname, '.');
+    if(dot == NULL)
+    {
+        return NULL;
+    }
+    for(int i = 0; format->extns[i] != NULL; i++)
+    {
+        if(!strcmp(dot, format->extns[i]))
+        {
+            return format->extns[i];
+        }
+    }
+    return NULL;
+}
+
+const ImageFormat *format_from_fname(const char *fname)
+{
+    for(uint i = 0; i < FORMAT_COUNT; i++)
+    {
+        if(format_extn(&formats[i], fname) != NULL)
+        {
+            return &formats[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Probe image content and parse header
+ * Input: image file ptr
+ * Output: ImageInfo of the image, file ptr positioned at 0
+ * Return Value: e_failure if no backend accepts the image
+ */
+Status read_image_info(FILE *fptr_image, ImageInfo *image)
+{
+    fseek(fptr_image, 0, SEEK_END);
+    long file_size = ftell(fptr_image);
+
+    for(uint i = 0; i < FORMAT_COUNT; i++)
+    {
+        fseek(fptr_image, 0, SEEK_SET);
+        if(formats[i].probe(fptr_image) == e_failure)
+        {
+            continue;
+        }
+        fseek(fptr_image, 0, SEEK_SET);
+        if(formats[i].parse_header(fptr_image, image) == e_failure)
+        {
+            return e_failure;
+        }
+        image->format = &formats[i];
+        fseek(fptr_image, 0, SEEK_SET);
+        if(file_size < 0 || image->pixel_offset > file_size || (long)image->pixel_size > file_size - image->pixel_offset)
+        {
+            printf("ERROR: %s pixel data is truncated\n", image->format->name);
+            return e_failure;
+        }
+        return e_success;
+    }
+    printf("ERROR: Unknown image format\n");
+    return e_failure;
+}
@@ -0,0 +1,56 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stdio.h>
+#include "types.h" // Contains user defined types
+
+struct _ImageFormat;
+
+/*
+ * Pixel region of a cover image, filled by the format backend.
+ * The LSB engine only touches pixel_size bytes starting at
+ * pixel_offset, everything before it is copied as header.
+ */
+typedef struct _ImageInfo
+{
+    const struct _ImageFormat *format;   //backend which parsed the header
+    uint width;
+    uint height;
+    uint channels;          //bytes per pixel
+    long pixel_offset;     //file offset of first pixel byte
+    uint pixel_size;      //number of pixel bytes usable for LSB
+
+} ImageInfo;
+
+/*
+ * Cover format backend
+ * probe        : e_success if file content looks like this format
+ * parse_header : fill ImageInfo, file position is not defined after it
+ * write_header : write header of stego image, src is positioned at 0
+ */
+typedef struct _ImageFormat
+{
+    const char *name;
+    const char *extns[3];   //file extensions, NULL terminated
+    Status (*probe)(FILE *fptr);
+    Status (*parse_header)(FILE *fptr, ImageInfo *image);
+    Status (*write_header)(FILE *fptr_src, FILE *fptr_dest, const ImageInfo *image);
+
+} ImageFormat;
+
+/* Find backend from file name extension, NULL if not supported */
+const ImageFormat *format_from_fname(const char *fname);
+
+/* Get extension of fname handled by format, NULL if none */
+const char *format_extn(const ImageFormat *format, const char *fname);
+
+/* Probe image content and parse header with matching backend */
+Status read_image_info(FILE *fptr_image, ImageInfo *image);
+
+/* Copy header bytes (everything before pixel data) unchanged */
+Status copy_raw_header(FILE *fptr_src, FILE *fptr_dest, const ImageInfo *image);
+
+/* Supported extensions for messages */
+#define SUPPORTED_IMAGE_EXTNS ".bmp/.ppm/.pgm/.tga"
+
+#endif
@@ -0,0 +1,268 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Asynchronous file I/O for batch mode.
+
+              io_uring is driven with raw syscalls (no liburing needed): a
+              submission queue entry is filled per read / write, and all
+              entries queued since the last wait are handed to the kernel by
+              one io_uring_enter in io_wait_completion, which also waits for
+              a completion when none is ready. Many cover reads and stego
+              writes can be in flight while the caller runs the LSB encoding
+              of images which are already loaded.
+
+              When io_uring_setup fails (old kernel, seccomp, container
+              policy) the engine falls back to blocking pread / pwrite.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include "ioengine.h"
+#include "types.h"
+
+//to read / write ring indexes shared with the kernel
+#define LOAD_ACQUIRE(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static int sys_io_uring_setup(uint entries, struct io_uring_params *params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int sys_io_uring_enter(int fd, uint to_submit, uint min_complete, uint flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+//to map submission and completion rings, e_failure leaves nothing mapped
+static Status io_uring_map(IoEngine *io, struct io_uring_params *params)
+{
+    io->sq_ring_size = params->sq_off.array + params->sq_entries * sizeof(uint);
+    io->cq_ring_size = params->cq_off.cqes + params->cq_entries * sizeof(struct io_uring_cqe);
+    if(params->features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if(io->cq_ring_size > io->sq_ring_size)
+        {
+            io->sq_ring_size = io->cq_ring_size;
+        }
+        io->cq_ring_size = io->sq_ring_size;
+    }
+
+    io->sq_ring_ptr = mmap(NULL, io->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io->ring_fd, IORING_OFF_SQ_RING);
+    if(io->sq_ring_ptr == MAP_FAILED)
+    {
+        return e_failure;
+    }
+    if(params->features & IORING_FEAT_SINGLE_MMAP)
+    {
+        io->cq_ring_ptr = io->sq_ring_ptr;
+    }
+    else
+    {
+        io->cq_ring_ptr = mmap(NULL, io->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io->ring_fd, IORING_OFF_CQ_RING);
+        if(io->cq_ring_ptr == MAP_FAILED)
+        {
+            munmap(io->sq_ring_ptr, io->sq_ring_size);
+            return e_failure;
+        }
+    }
+
+    io->sqes_size = params->sq_entries * sizeof(struct io_uring_sqe);
+    io->sqes = mmap(NULL, io->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, io->ring_fd, IORING_OFF_SQES);
+    if(io->sqes == MAP_FAILED)
+    {
+        if(io->cq_ring_ptr != io->sq_ring_ptr)
+        {
+            munmap(io->cq_ring_ptr, io->cq_ring_size);
+        }
+        munmap(io->sq_ring_ptr, io->sq_ring_size);
+        return e_failure;
+    }
+
+    char *sq = io->sq_ring_ptr;
+    char *cq = io->cq_ring_ptr;
+    io->sq_head = (uint *)(sq + params->sq_off.head);
+    io->sq_tail = (uint *)(sq + params->sq_off.tail);
+    io->sq_mask = (uint *)(sq + params->sq_off.ring_mask);
+    io->sq_array = (uint *)(sq + params->sq_off.array);
+    io->cq_head = (uint *)(cq + params->cq_off.head);
+    io->cq_tail = (uint *)(cq + params->cq_off.tail);
+    io->cq_mask = (uint *)(cq + params->cq_off.ring_mask);
+    io->cqes = cq + params->cq_off.cqes;
+    return e_success;
+}
+
+Status io_engine_init(IoEngine *io, uint depth)
+{
+    memset(io, 0, sizeof(*io));
+    if(depth == 0 || depth > IO_ENGINE_MAX_DEPTH)
+    {
+        printf("ERROR: Queue depth must be 1 to %d\n", IO_ENGINE_MAX_DEPTH);
+        return e_failure;
+    }
+    io->depth = depth;
+    io->ring_fd = -1;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    io->ring_fd = sys_io_uring_setup(depth, &params);
+    if(io->ring_fd >= 0 && io_uring_map(io, &params) == e_success)
+    {
+        io->use_uring = 1;
+        printf("INFO: Using io_uring, queue depth %u\n", depth);
+        return e_success;
+    }
+
+    if(io->ring_fd >= 0)
+    {
+        close(io->ring_fd);
+        io->ring_fd = -1;
+    }
+    printf("INFO: io_uring not available (%s), using blocking pread/pwrite\n", strerror(errno));
+    return e_success;
+}
+
+//to queue one request, op is IORING_OP_READ or IORING_OP_WRITE
+static Status io_submit(IoEngine *io, int op, int fd, void *buf, uint len, long offset, unsigned long tag)
+{
+    if(io->in_flight >= io->depth)
+    {
+        printf("ERROR: I/O queue is full\n");
+        return e_failure;
+    }
+
+    if(!io->use_uring)
+    {
+        IoCompletion *c = &io->done[(io->done_head + io->done_count) % IO_ENGINE_MAX_DEPTH];
+        ssize_t n = (op == IORING_OP_READ) ? pread(fd, buf, len, offset) : pwrite(fd, buf, len, offset);
+        c->tag = tag;
+        c->result = (n < 0) ? -errno : (int)n;
+        io->done_count++;
+        io->in_flight++;
+        return e_success;
+    }
+
+    //entry is only queued here, io_wait_completion submits all queued entries at once
+    uint tail = *io->sq_tail;
+    uint index = tail & *io->sq_mask;
+    struct io_uring_sqe *sqe = (struct io_uring_sqe *)io->sqes + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = op;
+    sqe->fd = fd;
+    sqe->addr = (unsigned long)buf;
+    sqe->len = len;
+    sqe->off = offset;
+    sqe->user_data = tag;
+    io->sq_array[index] = index;
+    STORE_RELEASE(io->sq_tail, tail + 1);
+    io->queued++;
+    io->in_flight++;
+    return e_success;
+}
+
+/*
+ * Submit queued entries and wait for min_complete completions
+ * Description: if io_uring_enter fails the kernel has taken no entry,
+ * so the tail is moved back and every queued request is completed
+ * with the error through the done queue, in_flight stays exact.
+ * Return Value: e_failure only if waiting failed with nothing queued
+ */
+static Status io_uring_flush(IoEngine *io, uint min_complete)
+{
+    int n = sys_io_uring_enter(io->ring_fd, io->queued, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0);
+    if(n >= 0)
+    {
+        io->queued -= ((uint)n < io->queued) ? (uint)n : io->queued;
+        return e_success;
+    }
+    if(errno == EINTR)
+    {
+        return e_success;
+    }
+    int err = errno;
+    perror("io_uring_enter");
+    if(io->queued == 0)
+    {
+        return e_failure;
+    }
+
+    uint tail = *io->sq_tail - io->queued;
+    for(uint i = 0; i < io->queued; i++)
+    {
+        struct io_uring_sqe *sqe = (struct io_uring_sqe *)io->sqes + ((tail + i) & *io->sq_mask);
+        IoCompletion *c = &io->done[(io->done_head + io->done_count) % IO_ENGINE_MAX_DEPTH];
+        c->tag = sqe->user_data;
+        c->result = -err;
+        io->done_count++;
+    }
+    STORE_RELEASE(io->sq_tail, tail);
+    io->queued = 0;
+    return e_success;
+}
+
+Status io_submit_read(IoEngine *io, int fd, void *buf, uint len, long offset, unsigned long tag)
+{
+    return io_submit(io, IORING_OP_READ, fd, buf, len, offset, tag);
+}
+
+Status io_submit_write(IoEngine *io, int fd, const void *buf, uint len, long offset, unsigned long tag)
+{
+    return io_submit(io, IORING_OP_WRITE, fd, (void *)buf, len, offset, tag);
+}
+
+Status io_wait_completion(IoEngine *io, IoCompletion *completion)
+{
+    if(io->in_flight == 0)
+    {
+        return e_failure;
+    }
+
+    //one enter submits everything queued, it waits only if no completion is ready
+    while(io->use_uring && io->done_count == 0 && (io->queued > 0 || *io->cq_head == LOAD_ACQUIRE(io->cq_tail)))
+    {
+        if(io_uring_flush(io, *io->cq_head == LOAD_ACQUIRE(io->cq_tail)) == e_failure)
+        {
+            return e_failure;
+        }
+    }
+
+    if(io->done_count > 0)   //blocking fallback results, or requests failed at submit
+    {
+        *completion = io->done[io->done_head];
+        io->done_head = (io->done_head + 1) % IO_ENGINE_MAX_DEPTH;
+        io->done_count--;
+        io->in_flight--;
+        return e_success;
+    }
+
+    uint head = *io->cq_head;
+    struct io_uring_cqe *cqe = (struct io_uring_cqe *)io->cqes + (head & *io->cq_mask);
+    completion->tag = cqe->user_data;
+    completion->result = cqe->res;
+    STORE_RELEASE(io->cq_head, head + 1);
+    io->in_flight--;
+    return e_success;
+}
+
+void io_engine_close(IoEngine *io)
+{
+    if(!io->use_uring)
+    {
+        return;
+    }
+    munmap(io->sqes, io->sqes_size);
+    if(io->cq_ring_ptr != io->sq_ring_ptr)
+    {
+        munmap(io->cq_ring_ptr, io->cq_ring_size);
+    }
+    munmap(io->sq_ring_ptr, io->sq_ring_size);
+    close(io->ring_fd);
+    io->use_uring = 0;
+}
@@ -0,0 +1,61 @@
+#ifndef IOENGINE_H
+#define IOENGINE_H
+
+#include "types.h" // Contains user defined types
+
+/*
+ * Asynchronous file I/O engine used by batch mode.
+ * Uses io_uring when the kernel allows it, otherwise reads and
+ * writes are done with blocking pread / pwrite at submit time and
+ * their results are handed out by io_wait_completion like completions.
+ * With io_uring, submit only queues the request; io_wait_completion
+ * hands all queued requests to the kernel in one io_uring_enter.
+ */
+
+#define IO_ENGINE_MAX_DEPTH 256
+
+typedef struct _IoCompletion
+{
+    unsigned long tag;   //tag given at submit
+    int result;         //bytes done or -errno
+
+} IoCompletion;
+
+typedef struct _IoEngine
+{
+    int use_uring;      //1 if io_uring is used
+    uint depth;        //max requests in flight
+    uint in_flight;   //queued, submitted or done requests not yet handed out
+    uint queued;     //io_uring entries queued, not yet taken by the kernel
+
+    /* io_uring rings */
+    int ring_fd;
+    uint *sq_head, *sq_tail, *sq_mask, *sq_array;
+    uint *cq_head, *cq_tail, *cq_mask;
+    void *sqes;
+    void *cqes;
+    void *sq_ring_ptr, *cq_ring_ptr;
+    unsigned long sq_ring_size, cq_ring_size, sqes_size;
+
+    /* blocking fallback completions, and io_uring requests failed at submit */
+    IoCompletion done[IO_ENGINE_MAX_DEPTH];
+    uint done_head, done_count;
+
+} IoEngine;
+
+/* Set up engine with given queue depth */
+Status io_engine_init(IoEngine *io, uint depth);
+
+/* Queue read of len bytes at offset from fd into buf */
+Status io_submit_read(IoEngine *io, int fd, void *buf, uint len, long offset, unsigned long tag);
+
+/* Queue write of len bytes from buf to fd at offset */
+Status io_submit_write(IoEngine *io, int fd, const void *buf, uint len, long offset, unsigned long tag);
+
+/* Submit queued requests and wait for one completion */
+Status io_wait_completion(IoEngine *io, IoCompletion *completion);
+
+/* Release rings */
+void io_engine_close(IoEngine *io);
+
+#endif
@@ -20,6 +20,25 @@ Description : This project implements LSB (Least Significant Bit) based Steganog
               ▪ Custom CLI interface supporting:
                     -e  for encoding operation
                     -d  for decoding operation
+                    -k  <password> to encrypt / decrypt the secret data
+                    -r  to add Reed-Solomon error correction to the secret data
+                    -b  <job list> to run many encode / decode jobs with async I/O
+                        (-q <queue depth>, -n <image buffers>)
+                    -D  <socket> to run as daemon serving requests (-t <worker threads>)
+                    -s  <socket> with -e / -d to send the request to the daemon
+                    -c  <chunk size> to encode a chunked payload which can be updated
+                    -m  <k> to matrix embed k bits per 2^k - 1 bytes (Hamming code),
+                        changing at most one LSB per group
+                    -p  with -e / -d to report cycles, instructions, cache / branch
+                        misses and syscalls of every stage (perf_event_open)
+                    -u  <stego image> <new secret> to re-embed only changed chunks
+                    -fe / -fd  to encode / decode a secret across a raw frame stream
+                        (-g <width>x<height>x<bytes per pixel>[+<header bytes>])
+                    -a  <image> (--analyze) to report chi-square / RS steganalysis
+                        statistics of an image (-t <threads>)
+                    -C  <job list> <address> to hand out jobs to workers (-l <lease seconds>)
+                    -W  <address> to run jobs of a coordinator, address is a
+                        unix socket path or host:port
 
               Output:
               Generates a new BMP file (stego image) with encoded data during encoding
@@ -30,9 +49,126 @@ Description : This project implements LSB (Least Significant Bit) based Steganog
 #include "encode.h"
 #include "decode.h"
 #include "types.h"
+#include "batch.h"
+#include "daemon.h"
+#include "update.h"
+#include "stream.h"
+#include "analyze.h"
+#include "cluster.h"
+#include "profile.h"
+#include <string.h>
+#include <stdlib.h>
+
+/*
+ * Extract optional settings from command line
+ * Input: argc, argv and options structure
+ * Output: options are removed from argv, remaining arguments are
+ * moved to the front so argv[2], argv[3]... are the file names
+ * Return Value: new argument count, -1 on invalid option
+ */
+int extract_options(int argc, char *argv[], StegoOptions *opts)
+{
+    int count = 2;   //argv[0] and argv[1] (-e/-d) are kept as is
+    opts->password = NULL;
+    opts->ecc = 0;
+    opts->queue_depth = 0;
+    opts->buffers = 0;
+    opts->threads = 0;
+    opts->socket_path = NULL;
+    opts->chunk_size = 0;
+    opts->geometry = NULL;
+    opts->lease_seconds = 0;
+    opts->matrix_k = 0;
+    opts->profile = 0;
+
+    for(int i = 2; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "-k"))
+        {
+            if(i + 1 >= argc)
+            {
+                printf("-k needs a password\n");
+                return -1;
+            }
+            opts->password = argv[++i];
+        }
+        else if(!strcmp(argv[i], "-r"))
+        {
+            opts->ecc = 1;
+        }
+        else if(!strcmp(argv[i], "-p"))
+        {
+            opts->profile = 1;
+        }
+        else if(!strcmp(argv[i], "-s"))
+        {
+            if(i + 1 >= argc)
+            {
+                printf("-s needs a socket path\n");
+                return -1;
+            }
+            opts->socket_path = argv[++i];
+        }
+        else if(!strcmp(argv[i], "-g"))
+        {
+            if(i + 1 >= argc)
+            {
+                printf("-g needs a frame geometry\n");
+                return -1;
+            }
+            opts->geometry = argv[++i];
+        }
+        else if(!strcmp(argv[i], "-q") || !strcmp(argv[i], "-n") || !strcmp(argv[i], "-t") || !strcmp(argv[i], "-c") || !strcmp(argv[i], "-l") || !strcmp(argv[i], "-m"))
+        {
+            int value = (i + 1 < argc) ? atoi(argv[i + 1]) : 0;
+            if(value <= 0)
+            {
+                printf("%s needs a positive number\n", argv[i]);
+                return -1;
+            }
+            if(argv[i][1] == 'q')
+            {
+                opts->queue_depth = value;
+            }
+            else if(argv[i][1] == 'n')
+            {
+                opts->buffers = value;
+            }
+            else if(argv[i][1] == 'c')
+            {
+                opts->chunk_size = value;
+            }
+            else if(argv[i][1] == 'l')
+            {
+                opts->lease_seconds = value;
+            }
+            else if(argv[i][1] == 'm')
+            {
+                opts->matrix_k = value;
+            }
+            else
+            {
+                opts->threads = value;
+            }
+            i++;
+        }
+        else
+        {
+            argv[count++] = argv[i];
+        }
+    }
+    argv[count] = NULL;
+    return count;
+}
 
 int main(int argc, char* argv[])
 {
+    StegoOptions opts;
+    if(argc >= 2)
+    {
+        argc = extract_options(argc, argv, &opts);
+    }
+
     //to validate argument count
     if(!(argc == 3 || argc == 4 || argc == 5))  //count should be 4 or 5
     {
@@ -46,19 +182,83 @@ int main(int argc, char* argv[])
     if(op_type == e_encode)
     {
         EncodeInfo encInfo;  //structure variable declaration
-        if(read_and_validate_encode_args(argv, &encInfo, argc) == e_success)
+        if(opts.socket_path != NULL)
+        {
+            daemon_client_encode(argv, argc, &opts);
+        }
+        else if(read_and_validate_encode_args(argv, &encInfo, argc) == e_success && set_encode_options(&encInfo, &opts) == e_success)
         {
-            do_encoding(&encInfo);
+            ProfileInfo prof;
+            if(opts.profile)
+            {
+                profile_open(&prof);
+                encInfo.profile = &prof;
+            }
+            Status status = do_encoding(&encInfo);
+            if(opts.profile)
+            {
+                //payload size is known once capacity was checked
+                profile_report(&prof, (status == e_success) ? encInfo.secret_file_size : 0);
+                profile_close(&prof);
+            }
         }
     }
     else if(op_type == e_decode)
     {
         DecodeInfo decInfo; //struct variable declaration
-        if(read_and_validate_decode_args(argv, &decInfo, argc) == e_success)
+        if(opts.socket_path != NULL)
+        {
+            daemon_client_decode(argv, argc, &opts);
+        }
+        else if(read_and_validate_decode_args(argv, &decInfo, argc) == e_success)
         {
-            do_decoding(&decInfo);
+            decInfo.password = opts.password;
+            ProfileInfo prof;
+            if(opts.profile)
+            {
+                profile_open(&prof);
+                decInfo.profile = &prof;
+            }
+            Status status = do_decoding(&decInfo);
+            if(opts.profile)
+            {
+                profile_report(&prof, (status == e_success) ? decInfo.secret_file_size : 0);
+                profile_close(&prof);
+            }
         }
     }
+    else if(op_type == e_batch)
+    {
+        do_batch(argv[2], &opts);
+    }
+    else if(op_type == e_daemon)
+    {
+        do_daemon(argv[2], &opts);
+    }
+    else if(op_type == e_update)
+    {
+        do_update(argv, argc, &opts);
+    }
+    else if(op_type == e_stream_encode)
+    {
+        do_stream_encoding(argv, argc, &opts);
+    }
+    else if(op_type == e_stream_decode)
+    {
+        do_stream_decoding(argv, argc, &opts);
+    }
+    else if(op_type == e_analyze)
+    {
+        do_analyze(argv[2], &opts);
+    }
+    else if(op_type == e_coordinator)
+    {
+        do_coordinator(argv[2], argv[3], &opts);
+    }
+    else if(op_type == e_worker)
+    {
+        do_worker(argv[2], &opts);
+    }
     else if(op_type == e_unsupported)
     {
         printf("Unsupported cmd arguments\n");
@@ -0,0 +1,167 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Matrix embedding of the secret data with the Hamming
+              [2^k - 1, k] code (see matrix.h), enabled with -m <k>.
+
+              Plain LSB embedding changes one cover LSB for about every
+              second payload bit. Here k bits are carried by 2^k - 1 cover
+              bytes and at most one of them is changed, so fewer cover bytes
+              are modified per payload bit, at the cost of capacity.
+
+              The syndrome is table driven: LSBs of 8 cover bytes are packed
+              into a mask with one multiply, and a 256 entry table gives the
+              XOR of the set bit positions and their parity, so one lookup
+              handles 8 cover bytes.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "matrix.h"
+#include "types.h"
+
+/* XOR of set bit positions of mask (bits 0-2) and parity of mask (bit 3) */
+static unsigned char syndrome_table[256];
+static pthread_once_t table_once = PTHREAD_ONCE_INIT;
+
+//to build syndrome table
+static void matrix_init(void)
+{
+    for(int mask = 0; mask < 256; mask++)
+    {
+        uint positions = 0, parity = 0;
+        for(int j = 0; j < 8; j++)
+        {
+            if(mask & (1 << j))
+            {
+                positions ^= j;
+                parity ^= 1;
+            }
+        }
+        syndrome_table[mask] = positions | (parity << 3);
+    }
+}
+
+//to pack LSBs of 8 bytes, bit j of mask is LSB of p[j]
+static inline uint lsb_mask8(const unsigned char *p)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return ((v & 0x0101010101010101ULL) * 0x0102040810204080ULL) >> 56;
+#else
+    uint mask = 0;
+    for(int j = 0; j < 8; j++)
+    {
+        mask |= (p[j] & 1) << j;
+    }
+    return mask;
+#endif
+}
+
+long matrix_cover_size(long size, uint k)
+{
+    long groups = (size * 8 + k - 1) / k;
+    return groups * ((1L << k) - 1);
+}
+
+/*
+ * Syndrome of one group
+ * Description: index space 0 .. 2^k - 1 is split into blocks of 8,
+ * index 0 has no cover byte. Block at base contributes the XOR of
+ * its set positions, plus base once for every set bit.
+ */
+static inline uint group_syndrome(const unsigned char *cover, uint k)
+{
+    uint indices = 1u << k;
+    uint mask = (lsb_mask8(cover) << 1) & ((indices < 8) ? (1u << indices) - 1 : 0xff);   //index 0 is empty
+    uint entry = syndrome_table[mask];
+    uint syndrome = entry & 7;
+    for(uint base = 8; base < indices; base += 8)
+    {
+        entry = syndrome_table[lsb_mask8(cover + base - 1)];
+        syndrome ^= (entry & 7) ^ ((entry >> 3) * base);
+    }
+    return syndrome;
+}
+
+//table is built here too, embed / extract loops call group_syndrome directly
+uint matrix_syndrome(const unsigned char *cover, uint k)
+{
+    pthread_once(&table_once, matrix_init);
+    return group_syndrome(cover, k);
+}
+
+//to get k payload bits at bit position pos, bits after payload are 0
+static inline uint get_bits(const unsigned char *data, long size, long pos, uint k)
+{
+    long byte = pos >> 3;
+    uint window = (data[byte] << 8) | ((byte + 1 < size) ? data[byte + 1] : 0);
+    return (window >> (16 - (pos & 7) - k)) & ((1u << k) - 1);
+}
+
+//to store k payload bits at bit position pos, data must be zeroed
+static inline void put_bits(unsigned char *data, long size, long pos, uint k, uint bits)
+{
+    long byte = pos >> 3;
+    uint window = bits << (16 - (pos & 7) - k);
+    data[byte] |= window >> 8;
+    if(byte + 1 < size)
+    {
+        data[byte + 1] |= window & 0xff;
+    }
+}
+
+/*
+ * Embed payload
+ * Input: data, k, cover of matrix_cover_size() bytes plus MATRIX_COVER_PADDING
+ * Output: cover LSBs changed, at most one per group
+ */
+Status matrix_embed(const unsigned char *data, long size, uint k, unsigned char *cover, long *changed)
+{
+    if(k < MATRIX_MIN_K || k > MATRIX_MAX_K)
+    {
+        return e_failure;
+    }
+    pthread_once(&table_once, matrix_init);
+    long groups = (size * 8 + k - 1) / k;
+    uint n = (1u << k) - 1;
+    *changed = 0;
+    for(long g = 0; g < groups; g++)
+    {
+        unsigned char *group = cover + g * n;
+        uint diff = group_syndrome(group, k) ^ get_bits(data, size, g * k, k);
+        if(diff)
+        {
+            group[diff - 1] ^= 1;   //flipping byte with index diff fixes the syndrome
+            (*changed)++;
+        }
+    }
+    return e_success;
+}
+
+/*
+ * Extract payload
+ * Input: cover of matrix_cover_size() bytes plus MATRIX_COVER_PADDING, k
+ * Output: size bytes of data
+ */
+Status matrix_extract(const unsigned char *cover, long size, uint k, unsigned char *data)
+{
+    if(k < MATRIX_MIN_K || k > MATRIX_MAX_K)
+    {
+        return e_failure;
+    }
+    pthread_once(&table_once, matrix_init);
+    long groups = (size * 8 + k - 1) / k;
+    uint n = (1u << k) - 1;
+    memset(data, 0, size);
+    for(long g = 0; g < groups; g++)
+    {
+        put_bits(data, size, g * k, k, group_syndrome(cover + g * n, k));
+    }
+    return e_success;
+}
@@ -0,0 +1,34 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include "types.h" // Contains user defined types
+
+/* Hamming [2^k - 1, k] matrix embedding, k payload bits per group */
+#define MATRIX_MIN_K 2
+#define MATRIX_MAX_K 8
+
+/* Cover buffers are read 8 bytes at a time, allocate this many extra bytes */
+#define MATRIX_COVER_PADDING 8
+
+/*
+ * Layout: payload bits (MSB first, byte after byte, zero padded) are
+ * taken k at a time, group g is carried by cover bytes
+ * g * (2^k - 1) ... g * (2^k - 1) + 2^k - 2.
+ * Cover byte i of a group has index i + 1, the k bits are the XOR of
+ * the indices of cover bytes with LSB 1 (Hamming syndrome), so at most
+ * one LSB per group is changed.
+ */
+
+/* Number of cover bytes carrying size bytes of payload */
+long matrix_cover_size(long size, uint k);
+
+/* Syndrome of one group, cover must be readable 8 bytes past the group */
+uint matrix_syndrome(const unsigned char *cover, uint k);
+
+/* Embed size bytes of data into cover LSBs, changed gets number of modified cover bytes */
+Status matrix_embed(const unsigned char *data, long size, uint k, unsigned char *cover, long *changed);
+
+/* Extract size bytes of data from cover LSBs */
+Status matrix_extract(const unsigned char *cover, long size, uint k, unsigned char *data);
+
+#endif
@@ -0,0 +1,370 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Profiling of encoding / decoding stages (-p), to see whether
+              a host is bound by syscalls, cache misses or the bit loops.
+
+              Hardware counters (cycles, instructions, cache misses, branch
+              misses) and a raw_syscalls:sys_enter tracepoint are opened with
+              perf_event_open for the calling thread. At every stage
+              boundary all counters are read once and the deltas are added
+              to the stage, so stages cost one read per counter.
+
+              Counters which can not be opened (no PMU in a VM, perf_event_paranoid)
+              are shown as n/a. Kernel counting is dropped first when not
+              permitted, and syscalls fall back to the read / write counts
+              of /proc/self/io when the tracepoint is not available.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "profile.h"
+#include "types.h"
+
+static const char *counter_names[e_prof_counters] = {"cycles", "instructions", "cache misses", "branch misses", "syscalls"};
+
+static const char *tracepoint_id_files[] = {
+    "/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+    "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+    NULL
+};
+
+//to open one counting event of calling thread on any cpu
+static int open_event(uint type, uint64_t config, int exclude_kernel)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = exclude_kernel;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+//to get id of raw_syscalls:sys_enter tracepoint, -1 if tracefs is not readable
+static long syscall_tracepoint_id(void)
+{
+    for(int i = 0; tracepoint_id_files[i] != NULL; i++)
+    {
+        FILE *fptr = fopen(tracepoint_id_files[i], "r");
+        if(fptr != NULL)
+        {
+            long id = -1;
+            if(fscanf(fptr, "%ld", &id) != 1)
+            {
+                id = -1;
+            }
+            fclose(fptr);
+            if(id >= 0)
+            {
+                return id;
+            }
+        }
+    }
+    return -1;
+}
+
+//to read syscr + syscw of /proc/self/io with a single read syscall
+static int read_proc_io(uint64_t *syscalls)
+{
+    char buf[512];
+    int fd = open("/proc/self/io", O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+    {
+        return -1;
+    }
+    ssize_t len = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if(len <= 0)
+    {
+        return -1;
+    }
+    buf[len] = '\0';
+    unsigned long long syscr, syscw;
+    char *line = strstr(buf, "syscr:");
+    if(line == NULL || sscanf(line, "syscr: %llu syscw: %llu", &syscr, &syscw) != 2)
+    {
+        return -1;
+    }
+    *syscalls = syscr + syscw;
+    return 0;
+}
+
+/*
+ * Open counters
+ * Input: profile structure
+ * Output: fd[] of available counters, -1 with error[] for others
+ * Return Value: e_success, also when no counter is available (time is still measured)
+ */
+Status profile_open(ProfileInfo *prof)
+{
+    static const uint64_t hw_config[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    memset(prof, 0, sizeof(*prof));
+    prof->current = -1;
+    prof->user_only = 0;
+
+    for(int i = e_prof_cycles; i <= e_prof_branch_misses; i++)
+    {
+        prof->fd[i] = open_event(PERF_TYPE_HARDWARE, hw_config[i], 0);
+        if(prof->fd[i] < 0 && (errno == EACCES || errno == EPERM))
+        {
+            //perf_event_paranoid 2 allows user space counting only
+            prof->fd[i] = open_event(PERF_TYPE_HARDWARE, hw_config[i], 1);
+            if(prof->fd[i] >= 0)
+            {
+                prof->user_only = 1;
+            }
+        }
+        prof->error[i] = (prof->fd[i] < 0) ? errno : 0;
+    }
+
+    prof->syscall_source = e_sys_none;
+    long id = syscall_tracepoint_id();
+    prof->fd[e_prof_syscalls] = (id >= 0) ? open_event(PERF_TYPE_TRACEPOINT, id, 0) : -1;
+    prof->error[e_prof_syscalls] = (id >= 0) ? errno : ENOENT;
+    uint64_t syscalls;
+    if(prof->fd[e_prof_syscalls] >= 0)
+    {
+        prof->syscall_source = e_sys_tracepoint;
+        prof->error[e_prof_syscalls] = 0;
+    }
+    else if(read_proc_io(&syscalls) == 0)
+    {
+        prof->syscall_source = e_sys_proc_io;
+    }
+
+    //reads done at each boundary fall into the next stage, they are taken off again
+    for(int i = 0; i < e_prof_counters; i++)
+    {
+        if(prof->fd[i] >= 0)
+        {
+            prof->lap_syscalls++;
+        }
+    }
+    if(prof->syscall_source == e_sys_proc_io)
+    {
+        prof->lap_syscalls++;   //read of /proc/self/io, open and close are not in syscr / syscw
+    }
+
+    //first boundary, nothing is measured before it
+    profile_stage(prof, NULL);
+    return e_success;
+}
+
+//to read value, time enabled, time running of all counters, syscall counter first
+static void read_counters(ProfileInfo *prof, uint64_t now[e_prof_counters][3])
+{
+    static const int order[e_prof_counters] = {e_prof_syscalls, e_prof_cycles, e_prof_instructions, e_prof_cache_misses, e_prof_branch_misses};
+    memset(now, 0, sizeof(uint64_t) * e_prof_counters * 3);
+    for(int j = 0; j < e_prof_counters; j++)
+    {
+        int i = order[j];
+        if(prof->fd[i] >= 0)
+        {
+            if(read(prof->fd[i], now[i], sizeof(now[i])) != sizeof(now[i]))
+            {
+                memset(now[i], 0, sizeof(now[i]));
+            }
+        }
+        else if(i == e_prof_syscalls && prof->syscall_source == e_sys_proc_io)
+        {
+            read_proc_io(&now[i][0]);
+            now[i][1] = now[i][2] = 1;   //never multiplexed
+        }
+    }
+}
+
+/*
+ * Stage boundary
+ * Input: profile (NULL when not profiling), name of next stage or NULL
+ * Output: deltas since last boundary are added to current stage
+ */
+void profile_stage(ProfileInfo *prof, const char *name)
+{
+    if(prof == NULL)
+    {
+        return;
+    }
+    uint64_t now[e_prof_counters][3];
+    read_counters(prof, now);
+    struct timespec time_now;
+    clock_gettime(CLOCK_MONOTONIC, &time_now);
+
+    if(prof->current >= 0)
+    {
+        ProfileStage *stage = &prof->stages[prof->current];
+        stage->ns += (time_now.tv_sec - prof->last_time.tv_sec) * 1e9 + (time_now.tv_nsec - prof->last_time.tv_nsec);
+        for(int i = 0; i < e_prof_counters; i++)
+        {
+            double value = now[i][0] - prof->last[i][0];
+            double enabled = now[i][1] - prof->last[i][1];
+            double running = now[i][2] - prof->last[i][2];
+            //counter shared the PMU with other events, scale to the whole stage
+            if(running > 0 && running < enabled)
+            {
+                value = value * enabled / running;
+            }
+            if(i == e_prof_syscalls)
+            {
+                value = (value > prof->lap_syscalls) ? value - prof->lap_syscalls : 0;
+            }
+            stage->count[i] += value;
+        }
+    }
+
+    prof->current = -1;
+    if(name != NULL)
+    {
+        for(int i = 0; i < prof->stage_count; i++)
+        {
+            if(!strcmp(prof->stages[i].name, name))
+            {
+                prof->current = i;
+            }
+        }
+        if(prof->current < 0 && prof->stage_count < PROFILE_MAX_STAGES)
+        {
+            prof->current = prof->stage_count++;
+            prof->stages[prof->current].name = name;
+        }
+    }
+    memcpy(prof->last, now, sizeof(now));
+    prof->last_time = time_now;
+}
+
+//to tell whether counter i has values
+static int counter_available(const ProfileInfo *prof, int i)
+{
+    if(i == e_prof_syscalls)
+    {
+        return prof->syscall_source != e_sys_none;
+    }
+    return prof->fd[i] >= 0;
+}
+
+//to print one row of stage table, values are divided by per_bytes unless it is 0
+static void print_row(const ProfileInfo *prof, const char *name, double ns, const double *count, long per_bytes)
+{
+    char cell[32];
+    double div = per_bytes;
+    if(per_bytes == 0)
+    {
+        printf("%-16s %10.3f", name, ns / 1e6);   //ms
+    }
+    else
+    {
+        printf("%-16s %10.3f", name, ns / div);   //ns per byte
+    }
+    for(int i = 0; i < e_prof_counters; i++)
+    {
+        if(!counter_available(prof, i))
+        {
+            strcpy(cell, "n/a");
+        }
+        else if(per_bytes == 0)
+        {
+            snprintf(cell, sizeof(cell), "%.0f", count[i]);
+        }
+        else
+        {
+            snprintf(cell, sizeof(cell), "%.3f", count[i] / div);
+        }
+        printf(" %14s", cell);
+    }
+    if(counter_available(prof, e_prof_cycles) && counter_available(prof, e_prof_instructions) && count[e_prof_cycles] > 0)
+    {
+        printf(" %6.2f", count[e_prof_instructions] / count[e_prof_cycles]);
+    }
+    else
+    {
+        printf(" %6s", "n/a");
+    }
+    printf("\n");
+}
+
+/*
+ * Print profile
+ * Input: profile, payload bytes (secret file size)
+ * Output: one row per stage, total, total per payload byte
+ */
+void profile_report(ProfileInfo *prof, long payload_bytes)
+{
+    profile_stage(prof, NULL);   //ends last stage if still running
+
+    printf("INFO: ## Profile ##\n");
+    for(int i = 0; i < e_prof_counters; i++)
+    {
+        if(!counter_available(prof, i))
+        {
+            const char *hint = "";
+            if(prof->error[i] == EACCES || prof->error[i] == EPERM)
+            {
+                hint = ", see /proc/sys/kernel/perf_event_paranoid";
+            }
+            else if(i != e_prof_syscalls && (prof->error[i] == ENOENT || prof->error[i] == EOPNOTSUPP))
+            {
+                hint = ", no hardware PMU (virtual machine?)";
+            }
+            printf("INFO: %s counter not available (%s)%s\n", counter_names[i], strerror(prof->error[i]), hint);
+        }
+    }
+    if(prof->user_only)
+    {
+        printf("INFO: Kernel counting not permitted, hardware counters are user space only\n");
+    }
+    if(prof->syscall_source == e_sys_proc_io)
+    {
+        printf("INFO: raw_syscalls tracepoint not available (%s), syscalls are read / write family from /proc/self/io\n", strerror(prof->error[e_prof_syscalls]));
+    }
+
+    printf("%-16s %10s", "stage", "ms");
+    for(int i = 0; i < e_prof_counters; i++)
+    {
+        printf(" %14s", counter_names[i]);
+    }
+    printf(" %6s\n", "IPC");
+
+    ProfileStage total;
+    memset(&total, 0, sizeof(total));
+    for(int s = 0; s < prof->stage_count; s++)
+    {
+        print_row(prof, prof->stages[s].name, prof->stages[s].ns, prof->stages[s].count, 0);
+        total.ns += prof->stages[s].ns;
+        for(int i = 0; i < e_prof_counters; i++)
+        {
+            total.count[i] += prof->stages[s].count[i];
+        }
+    }
+    print_row(prof, "total", total.ns, total.count, 0);
+
+    if(payload_bytes > 0)
+    {
+        printf("Per payload byte (%ld bytes), time in ns:\n", payload_bytes);
+        for(int s = 0; s < prof->stage_count; s++)
+        {
+            print_row(prof, prof->stages[s].name, prof->stages[s].ns, prof->stages[s].count, payload_bytes);
+        }
+        print_row(prof, "total", total.ns, total.count, payload_bytes);
+    }
+}
+
+void profile_close(ProfileInfo *prof)
+{
+    for(int i = 0; i < e_prof_counters; i++)
+    {
+        if(prof->fd[i] >= 0)
+        {
+            close(prof->fd[i]);
+            prof->fd[i] = -1;
+        }
+    }
+}
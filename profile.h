@@ -0,0 +1,67 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <time.h>
+#include "types.h" // Contains user defined types
+
+/* Stages of one encoding / decoding, stages with the same name are added up */
+#define PROFILE_MAX_STAGES 16
+
+/* Counters read at every stage boundary, index into fd / count arrays */
+typedef enum
+{
+    e_prof_cycles,
+    e_prof_instructions,
+    e_prof_cache_misses,
+    e_prof_branch_misses,
+    e_prof_syscalls,
+    e_prof_counters
+} ProfileCounter;
+
+/* Where syscall count comes from */
+typedef enum
+{
+    e_sys_none,
+    e_sys_tracepoint,   //raw_syscalls:sys_enter tracepoint, every syscall
+    e_sys_proc_io      //syscr + syscw of /proc/self/io, read / write family only
+} SyscallSource;
+
+/* Time and counter deltas spent in one stage */
+typedef struct _ProfileStage
+{
+    const char *name;
+    double ns;
+    double count[e_prof_counters];
+
+} ProfileStage;
+
+typedef struct _ProfileInfo
+{
+    int fd[e_prof_counters];             //perf event fd, -1 if counter is not available
+    int error[e_prof_counters];         //errno of perf_event_open when not available
+    SyscallSource syscall_source;
+    uint64_t last[e_prof_counters][3];   //value, time enabled, time running at last boundary
+    struct timespec last_time;
+    int lap_syscalls;                  //syscalls done by the profiler itself per boundary
+    int user_only;                    //hardware counters exclude kernel, not permitted
+
+    int current;                     //stage being measured, -1 if none
+    int stage_count;
+    ProfileStage stages[PROFILE_MAX_STAGES];
+
+} ProfileInfo;
+
+/* Open counters of calling thread, unavailable counters are reported as n/a */
+Status profile_open(ProfileInfo *prof);
+
+/* End current stage and start stage name, NULL only ends current stage, prof may be NULL */
+void profile_stage(ProfileInfo *prof, const char *name);
+
+/* Print stage table, totals and totals per payload byte */
+void profile_report(ProfileInfo *prof, long payload_bytes);
+
+/* Close counters */
+void profile_close(ProfileInfo *prof);
+
+#endif
@@ -0,0 +1,439 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Reed-Solomon RS(255,223) error correction for the secret data,
+              so a few flipped LSBs in the stego image do not corrupt the
+              decoded file.
+
+              Codewords are interleaved byte wise (see rs.h). Because of that,
+              byte j of every codeword is stored next to each other, and the
+              encoder LFSR and the decoder syndromes are computed for all
+              codewords at once with GF(256) region multiplies by a constant.
+
+              A region multiply uses two 16 entry tables per constant (low and
+              high nibble). On x86 CPUs with SSSE3, checked at run time, these
+              tables are looked up 16 bytes at a time using pshufb, otherwise
+              the same tables are used byte by byte. Only codewords with non zero syndromes go through the
+              scalar Berlekamp-Massey / Chien / Forney correction.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "rs.h"
+#include "types.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#define RS_HAVE_SSSE3 1   //pshufb kernels are built with target("ssse3"), used if the CPU has it
+#endif
+
+static unsigned char gf_exp[512];      //alpha^i, doubled to skip modulo
+static unsigned char gf_log[256];
+static unsigned char mul_lo[256][16];  //c * low nibble
+static unsigned char mul_hi[256][16];  //c * (high nibble << 4)
+static unsigned char rs_gen[RS_PARITY + 1];   //generator polynomial, highest degree first
+static pthread_once_t table_once = PTHREAD_ONCE_INIT;
+static int use_ssse3 = 0;   //set by rs_init from cpuid
+
+static unsigned char gf_mul(unsigned char a, unsigned char b)
+{
+    if(a == 0 || b == 0)
+    {
+        return 0;
+    }
+    return gf_exp[gf_log[a] + gf_log[b]];
+}
+
+static unsigned char gf_div(unsigned char a, unsigned char b)
+{
+    if(a == 0)
+    {
+        return 0;
+    }
+    return gf_exp[gf_log[a] + 255 - gf_log[b]];
+}
+
+//to build GF(256) tables and generator polynomial
+static void rs_build_tables(void)
+{
+    //to build exp and log tables with primitive polynomial x^8 + x^4 + x^3 + x^2 + 1
+    int x = 1;
+    for(int i = 0; i < 255; i++)
+    {
+        gf_exp[i] = x;
+        gf_log[x] = i;
+        x <<= 1;
+        if(x & 0x100)
+        {
+            x ^= 0x11d;
+        }
+    }
+    for(int i = 255; i < 512; i++)
+    {
+        gf_exp[i] = gf_exp[i - 255];
+    }
+
+    //to build nibble tables for region multiply
+    for(int c = 0; c < 256; c++)
+    {
+        for(int n = 0; n < 16; n++)
+        {
+            mul_lo[c][n] = gf_mul(c, n);
+            mul_hi[c][n] = gf_mul(c, n << 4);
+        }
+    }
+
+    //to build g(x) = (x - alpha^0)(x - alpha^1)...(x - alpha^31)
+    memset(rs_gen, 0, sizeof(rs_gen));
+    rs_gen[0] = 1;
+    for(int i = 0; i < RS_PARITY; i++)
+    {
+        for(int j = i + 1; j > 0; j--)
+        {
+            rs_gen[j] ^= gf_mul(rs_gen[j - 1], gf_exp[i]);
+        }
+    }
+
+#ifdef RS_HAVE_SSSE3
+    __builtin_cpu_init();
+    use_ssse3 = __builtin_cpu_supports("ssse3");
+#endif
+}
+
+void rs_init(void)
+{
+    pthread_once(&table_once, rs_build_tables);   //tables are shared by daemon / batch worker threads
+}
+
+int rs_use_simd(int enable)
+{
+    rs_init();
+#ifdef RS_HAVE_SSSE3
+    use_ssse3 = enable && __builtin_cpu_supports("ssse3");
+#else
+    use_ssse3 = 0;
+    (void)enable;
+#endif
+    return use_ssse3;
+}
+
+#ifdef RS_HAVE_SSSE3
+//to do dst ^= c * src 16 bytes at a time, returns number of bytes done
+__attribute__((target("ssse3")))
+static uint region_mul_xor_ssse3(unsigned char *dst, const unsigned char *src, unsigned char c, uint len)
+{
+    uint i = 0;
+    __m128i lo = _mm_loadu_si128((const __m128i *)mul_lo[c]);
+    __m128i hi = _mm_loadu_si128((const __m128i *)mul_hi[c]);
+    __m128i mask = _mm_set1_epi8(0x0f);
+    for(; i + 16 <= len; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(v, mask));
+        __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(v, 4), mask));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(d, _mm_xor_si128(l, h)));
+    }
+    return i;
+}
+
+//to do dst = c * dst 16 bytes at a time, returns number of bytes done
+__attribute__((target("ssse3")))
+static uint region_mul_ssse3(unsigned char *dst, unsigned char c, uint len)
+{
+    uint i = 0;
+    __m128i lo = _mm_loadu_si128((const __m128i *)mul_lo[c]);
+    __m128i hi = _mm_loadu_si128((const __m128i *)mul_hi[c]);
+    __m128i mask = _mm_set1_epi8(0x0f);
+    for(; i + 16 <= len; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(v, mask));
+        __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(v, 4), mask));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(l, h));
+    }
+    return i;
+}
+#endif
+
+void gf_region_mul_xor(unsigned char *dst, const unsigned char *src, unsigned char c, uint len)
+{
+    uint i = 0;
+    if(c == 0)
+    {
+        return;
+    }
+#ifdef RS_HAVE_SSSE3
+    if(use_ssse3)
+    {
+        i = region_mul_xor_ssse3(dst, src, c, len);
+    }
+#endif
+    for(; i < len; i++)
+    {
+        dst[i] ^= mul_lo[c][src[i] & 0x0f] ^ mul_hi[c][src[i] >> 4];
+    }
+}
+
+void gf_region_mul(unsigned char *dst, unsigned char c, uint len)
+{
+    uint i = 0;
+#ifdef RS_HAVE_SSSE3
+    if(use_ssse3)
+    {
+        i = region_mul_ssse3(dst, c, len);
+    }
+#endif
+    for(; i < len; i++)
+    {
+        dst[i] = mul_lo[c][dst[i] & 0x0f] ^ mul_hi[c][dst[i] >> 4];
+    }
+}
+
+uint rs_encoded_size(uint size)
+{
+    uint blocks = (size + RS_K - 1) / RS_K;
+    return blocks * RS_N;
+}
+
+/*
+ * Encode data with RS(255,223)
+ * Input: data, size and output buffer of rs_encoded_size(size) bytes
+ * Description: LFSR division by g(x) run on all codewords at once,
+ * each register is a row of blocks bytes.
+ */
+Status rs_encode(const unsigned char *data, uint size, unsigned char *out)
+{
+    rs_init();
+    uint blocks = (size + RS_K - 1) / RS_K;
+    if(blocks == 0)
+    {
+        return e_success;
+    }
+
+    unsigned char *storage = calloc(RS_PARITY, blocks);
+    if(storage == NULL)
+    {
+        printf("ERROR: Unable to allocate memory for RS parity\n");
+        return e_failure;
+    }
+    unsigned char *reg[RS_PARITY];   //remainder rows, reg[0] is highest degree
+    for(int i = 0; i < RS_PARITY; i++)
+    {
+        reg[i] = storage + i * blocks;
+    }
+
+    //to copy data, zero padded, it is the systematic part of the codewords
+    memcpy(out, data, size);
+    memset(out + size, 0, RS_K * blocks - size);
+
+    for(int j = 0; j < RS_K; j++)
+    {
+        unsigned char *fb = reg[0];
+        const unsigned char *row = out + j * blocks;
+        for(uint c = 0; c < blocks; c++)
+        {
+            fb[c] ^= row[c];   //feedback = data ^ highest remainder
+        }
+        for(int i = 0; i < RS_PARITY - 1; i++)
+        {
+            reg[i] = reg[i + 1];
+            gf_region_mul_xor(reg[i], fb, rs_gen[i + 1], blocks);
+        }
+        gf_region_mul(fb, rs_gen[RS_PARITY], blocks);
+        reg[RS_PARITY - 1] = fb;
+    }
+
+    for(int i = 0; i < RS_PARITY; i++)
+    {
+        memcpy(out + (RS_K + i) * blocks, reg[i], blocks);
+    }
+    free(storage);
+    return e_success;
+}
+
+/*
+ * Correct one codeword given its syndromes
+ * Input: syndromes, encoded buffer, codeword index and interleave step
+ * Return Value: number of corrected bytes, -1 if uncorrectable
+ */
+static int rs_correct_codeword(const unsigned char *synd, unsigned char *encoded, uint col, uint step)
+{
+    unsigned char lambda[RS_PARITY + 1] = {1};   //error locator, lowest degree first
+    unsigned char prev[RS_PARITY + 1] = {1};
+    unsigned char temp[RS_PARITY + 1];
+    int L = 0, m = 1;
+    unsigned char b = 1;
+
+    //Berlekamp-Massey
+    for(int n = 0; n < RS_PARITY; n++)
+    {
+        unsigned char d = synd[n];
+        for(int i = 1; i <= L; i++)
+        {
+            d ^= gf_mul(lambda[i], synd[n - i]);
+        }
+        if(d == 0)
+        {
+            m++;
+            continue;
+        }
+        unsigned char coef = gf_div(d, b);
+        memcpy(temp, lambda, sizeof(temp));
+        for(int i = 0; i + m <= RS_PARITY; i++)
+        {
+            lambda[i + m] ^= gf_mul(coef, prev[i]);
+        }
+        if(2 * L <= n)
+        {
+            L = n + 1 - L;
+            memcpy(prev, temp, sizeof(prev));
+            b = d;
+            m = 1;
+        }
+        else
+        {
+            m++;
+        }
+    }
+    if(L > RS_PARITY / 2)
+    {
+        return -1;
+    }
+
+    //omega(x) = S(x) * lambda(x) mod x^32
+    unsigned char omega[RS_PARITY] = {0};
+    for(int i = 0; i < RS_PARITY; i++)
+    {
+        for(int j = 0; j <= i && j <= L; j++)
+        {
+            omega[i] ^= gf_mul(synd[i - j], lambda[j]);
+        }
+    }
+
+    //Chien search, byte j of codeword is coefficient of x^(254 - j)
+    //errors are collected first, codeword is changed only if all L roots are found
+    int position[RS_PARITY / 2];
+    unsigned char magnitude[RS_PARITY / 2];
+    int found = 0;
+    for(int j = 0; j < RS_N; j++)
+    {
+        int power = RS_N - 1 - j;
+        unsigned char x_inv = gf_exp[(255 - power) % 255];
+        unsigned char value = 0;
+        unsigned char xp = 1;
+        for(int i = 0; i <= L; i++)
+        {
+            value ^= gf_mul(lambda[i], xp);
+            xp = gf_mul(xp, x_inv);
+        }
+        if(value != 0)
+        {
+            continue;
+        }
+
+        //Forney: e = X * omega(X^-1) / lambda'(X^-1)
+        unsigned char num = 0, den = 0;
+        xp = 1;
+        for(int i = 0; i < RS_PARITY; i++)
+        {
+            num ^= gf_mul(omega[i], xp);
+            if(i & 1)
+            {
+                den ^= gf_mul(lambda[i], gf_exp[(gf_log[x_inv] * (i - 1)) % 255]);
+            }
+            xp = gf_mul(xp, x_inv);
+        }
+        if(den == 0 || found == L)
+        {
+            return -1;
+        }
+        position[found] = j;
+        magnitude[found] = gf_mul(gf_exp[power], gf_div(num, den));
+        found++;
+    }
+    if(found != L)
+    {
+        return -1;
+    }
+    for(int i = 0; i < found; i++)
+    {
+        encoded[position[i] * step + col] ^= magnitude[i];
+    }
+    return found;
+}
+
+/*
+ * Decode and correct encoded payload in place
+ * Input: encoded buffer and original data size
+ * Output: corrected data at start of buffer, corrected byte count
+ * Return Value: e_failure if any codeword had too many errors
+ */
+Status rs_decode(unsigned char *encoded, uint size, int *corrected)
+{
+    rs_init();
+    uint blocks = (size + RS_K - 1) / RS_K;
+    *corrected = 0;
+    if(blocks == 0)
+    {
+        return e_success;
+    }
+
+    unsigned char *synd = calloc(RS_PARITY, blocks);   //row i is S_i of every codeword
+    if(synd == NULL)
+    {
+        printf("ERROR: Unable to allocate memory for RS syndromes\n");
+        return e_failure;
+    }
+
+    //Horner evaluation of r(alpha^i) for all codewords at once
+    for(int j = 0; j < RS_N; j++)
+    {
+        const unsigned char *row = encoded + j * blocks;
+        for(int i = 0; i < RS_PARITY; i++)
+        {
+            unsigned char *s = synd + i * blocks;
+            if(i != 0)
+            {
+                gf_region_mul(s, gf_exp[i], blocks);
+            }
+            gf_region_mul_xor(s, row, 1, blocks);
+        }
+    }
+
+    uint failed = 0;
+    unsigned char col_synd[RS_PARITY];
+    for(uint c = 0; c < blocks; c++)
+    {
+        int error = 0;
+        for(int i = 0; i < RS_PARITY; i++)
+        {
+            col_synd[i] = synd[i * blocks + c];
+            error |= col_synd[i];
+        }
+        if(error == 0)
+        {
+            continue;
+        }
+        int fixed = rs_correct_codeword(col_synd, encoded, c, blocks);
+        if(fixed < 0)
+        {
+            failed++;
+        }
+        else
+        {
+            *corrected += fixed;
+        }
+    }
+    free(synd);
+    if(failed)
+    {
+        printf("ERROR: %u of %u RS codewords have too many errors to correct\n", failed, blocks);
+        return e_failure;
+    }
+    return e_success;
+}
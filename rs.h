@@ -0,0 +1,43 @@
+#ifndef RS_H
+#define RS_H
+
+#include "types.h" // Contains user defined types
+
+/* Reed-Solomon RS(255,223) over GF(256), corrects 16 byte errors per codeword */
+#define RS_N 255
+#define RS_K 223
+#define RS_PARITY (RS_N - RS_K)
+
+/*
+ * Encoded layout for a payload of size bytes split into
+ * blocks = ceil(size / RS_K) codewords, interleaved byte wise:
+ *
+ *   data (size bytes, zero padded to RS_K * blocks) | parity (RS_PARITY * blocks)
+ *
+ * Byte i of the data belongs to codeword i % blocks, so a burst of
+ * corrupted image bytes is spread across all codewords, and the
+ * data part stays readable in order.
+ */
+
+/* Build GF(256) tables and generator polynomial */
+void rs_init(void);
+
+/* Use SSSE3 region multiplies if enable and the CPU has SSSE3, returns 1 if they are used */
+int rs_use_simd(int enable);
+
+/* Size of encoded payload for size bytes of data */
+uint rs_encoded_size(uint size);
+
+/* Encode size bytes of data into out, out must hold rs_encoded_size(size) bytes */
+Status rs_encode(const unsigned char *data, uint size, unsigned char *out);
+
+/* Correct encoded payload in place, corrected gets number of fixed bytes */
+Status rs_decode(unsigned char *encoded, uint size, int *corrected);
+
+/* dst ^= c * src for len bytes */
+void gf_region_mul_xor(unsigned char *dst, const unsigned char *src, unsigned char c, uint len);
+
+/* dst = c * dst for len bytes */
+void gf_region_mul(unsigned char *dst, unsigned char c, uint len);
+
+#endif
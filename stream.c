@@ -0,0 +1,565 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Frame stream mode, spreads one long secret file over a
+              continuous stream of fixed size raw frames (raw RGB or a
+              sequence of BMP frames on a pipe) in a single process.
+
+              Frame geometry is given once with -g. Every frame which carries
+              payload starts its pixels with a sequence header (magic, flags,
+              sequence number, payload length in this frame), so the decoder
+              reassembles the secret in one pass and detects dropped or
+              reordered frames. Frames after the last payload frame are
+              copied unchanged.
+
+              A reader thread loads frame N+1 into the second buffer while
+              frame N is embedded / extracted and written. It reads the input
+              fd with read(2) after a poll on the fd and a wake up pipe, so it
+              can be stopped while the producer keeps the pipe open.
+
+              Usage:
+                    -fe <input stream> <secret> <output stream> -g <geometry>
+                    -fd <input stream> <output file> -g <geometry>
+              "-" as input stream reads stdin.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "stream.h"
+#include "encode.h"
+#include "decode.h"
+#include "common.h"
+#include "types.h"
+
+//to read one geometry number, digits only so signs and spaces are rejected
+static int read_geometry_field(const char *str, char **end, uint *value)
+{
+    if(!isdigit((unsigned char)*str))
+    {
+        return 0;
+    }
+    unsigned long n = strtoul(str, end, 10);
+    if(n > UINT_MAX)
+    {
+        return 0;
+    }
+    *value = n;
+    return 1;
+}
+
+/*
+ * Parse frame geometry
+ * Input: "<width>x<height>x<bytes per pixel>[+<header bytes>]"
+ * Return Value: e_failure if frame can not hold a sequence header and data
+ */
+Status parse_frame_geometry(const char *str, FrameGeometry *geo)
+{
+    char *end = NULL;
+    memset(geo, 0, sizeof(*geo));
+    int valid = read_geometry_field(str, &end, &geo->width) && *end == 'x' && read_geometry_field(end + 1, &end, &geo->height) && *end == 'x' && read_geometry_field(end + 1, &end, &geo->bpp);
+    if(valid && *end == '+')
+    {
+        valid = read_geometry_field(end + 1, &end, &geo->header_size);
+    }
+    //whole string must be geometry, "320x240x3junk" is rejected
+    if(!valid || *end != '\0')
+    {
+        printf("ERROR: Invalid frame geometry %s, expected <width>x<height>x<bytes per pixel>[+<header bytes>]\n", str);
+        return e_failure;
+    }
+    unsigned long long pixels = (unsigned long long)geo->width * geo->height * geo->bpp;
+    if(geo->bpp == 0 || geo->bpp > 4 || pixels == 0 || pixels + geo->header_size > (1u << 30))
+    {
+        printf("ERROR: Unsupported frame geometry %s\n", str);
+        return e_failure;
+    }
+    geo->pixel_size = pixels;
+    geo->frame_size = geo->header_size + geo->pixel_size;
+    if(geo->pixel_size / 8 <= STREAM_HEADER_BYTES)
+    {
+        printf("ERROR: Frame of %u pixel bytes is too small for a sequence header\n", geo->pixel_size);
+        return e_failure;
+    }
+    geo->capacity = geo->pixel_size / 8 - STREAM_HEADER_BYTES;
+    return e_success;
+}
+
+//to read one whole frame, returns bytes read, less than frame size at end of stream, -1 on error or stop
+static long read_frame(FrameQueue *q, char *frame)
+{
+    struct pollfd fds[2] = {{q->fd, POLLIN, 0}, {q->wake[0], POLLIN, 0}};
+    size_t done = 0;
+    while(done < q->frame_size)
+    {
+        if(poll(fds, 2, -1) < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            perror("poll");
+            return -1;
+        }
+        if(fds[1].revents)   //frame_queue_stop wrote to wake up pipe
+        {
+            return -1;
+        }
+        ssize_t n = read(q->fd, frame + done, q->frame_size - done);
+        if(n == 0)
+        {
+            break;
+        }
+        if(n < 0)
+        {
+            if(errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+            perror("read");
+            return -1;
+        }
+        done += n;
+    }
+    return done;
+}
+
+//reader thread, loads frames into free buffers until end of stream
+static void *frame_reader(void *arg)
+{
+    FrameQueue *q = arg;
+    while(1)
+    {
+        pthread_mutex_lock(&q->lock);
+        while(q->count == STREAM_BUFFERS && !q->stop)
+        {
+            pthread_cond_wait(&q->space, &q->lock);
+        }
+        int index = (q->head + q->count) % STREAM_BUFFERS;
+        int stop = q->stop;
+        pthread_mutex_unlock(&q->lock);
+        if(stop)
+        {
+            break;
+        }
+
+        //buffer is not touched by embed loop until count includes it
+        long len = read_frame(q, q->frames[index]);
+
+        pthread_mutex_lock(&q->lock);
+        if(q->stop)
+        {
+            pthread_mutex_unlock(&q->lock);
+            break;
+        }
+        if(len == q->frame_size)
+        {
+            q->count++;
+        }
+        else if(len == 0)
+        {
+            q->eof = 1;
+        }
+        else
+        {
+            if(len > 0)
+            {
+                printf("ERROR: Stream ended with a partial frame of %ld bytes\n", len);
+            }
+            q->error = 1;
+        }
+        int done = q->eof || q->error;
+        pthread_cond_signal(&q->ready);
+        pthread_mutex_unlock(&q->lock);
+        if(done)
+        {
+            break;
+        }
+    }
+    return NULL;
+}
+
+//to allocate frame buffers and start reader thread
+static Status frame_queue_start(FrameQueue *q, int fd, uint frame_size)
+{
+    memset(q, 0, sizeof(*q));
+    q->fd = fd;
+    q->frame_size = frame_size;
+    if(pipe(q->wake) != 0)
+    {
+        perror("pipe");
+        return e_failure;
+    }
+    for(int i = 0; i < STREAM_BUFFERS; i++)
+    {
+        q->frames[i] = malloc(frame_size);
+        if(q->frames[i] == NULL)
+        {
+            printf("ERROR: Unable to allocate frame buffers\n");
+            for(int j = 0; j < i; j++)
+            {
+                free(q->frames[j]);
+            }
+            close(q->wake[0]);
+            close(q->wake[1]);
+            return e_failure;
+        }
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->ready, NULL);
+    pthread_cond_init(&q->space, NULL);
+    if(pthread_create(&q->reader, NULL, frame_reader, q) != 0)
+    {
+        printf("ERROR: Unable to start frame reader thread\n");
+        for(int i = 0; i < STREAM_BUFFERS; i++)
+        {
+            free(q->frames[i]);
+        }
+        close(q->wake[0]);
+        close(q->wake[1]);
+        return e_failure;
+    }
+    return e_success;
+}
+
+//to wait for next frame, NULL at end of stream or on error
+static char *frame_queue_get(FrameQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    while(q->count == 0 && !q->eof && !q->error)
+    {
+        pthread_cond_wait(&q->ready, &q->lock);
+    }
+    char *frame = (q->count > 0) ? q->frames[q->head] : NULL;
+    pthread_mutex_unlock(&q->lock);
+    return frame;
+}
+
+//to give current frame buffer back to reader
+static void frame_queue_release(FrameQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    q->head = (q->head + 1) % STREAM_BUFFERS;
+    q->count--;
+    pthread_cond_signal(&q->space);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/*
+ * Stop reader thread and free buffers
+ * Description: the reader may be waiting in poll on a pipe which stays
+ * open after the last wanted frame, a byte on the wake up pipe makes it
+ * return instead of waiting for more input or end of stream.
+ * Return Value: e_failure if stream had a read error or partial frame
+ */
+static Status frame_queue_stop(FrameQueue *q)
+{
+    pthread_mutex_lock(&q->lock);
+    q->stop = 1;
+    pthread_cond_signal(&q->space);
+    pthread_mutex_unlock(&q->lock);
+    if(write(q->wake[1], "", 1) != 1)
+    {
+        perror("write");
+    }
+    pthread_join(q->reader, NULL);
+    close(q->wake[0]);
+    close(q->wake[1]);
+    for(int i = 0; i < STREAM_BUFFERS; i++)
+    {
+        free(q->frames[i]);
+    }
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->ready);
+    pthread_cond_destroy(&q->space);
+    return q->error ? e_failure : e_success;
+}
+
+//to open input stream, "-" is stdin
+static int open_input_stream(const char *fname)
+{
+    int fd = strcmp(fname, "-") ? open(fname, O_RDONLY) : STDIN_FILENO;
+    if(fd < 0)
+    {
+        perror("open");
+        fprintf(stderr, "ERROR: Unable to open file %s\n", fname);
+    }
+    return fd;
+}
+
+//to check stream mode options and parse geometry
+static Status read_stream_options(const StegoOptions *opts, FrameGeometry *geo)
+{
+    if(opts->geometry == NULL)
+    {
+        printf("ERROR: Frame stream mode needs -g <width>x<height>x<bytes per pixel>[+<header bytes>]\n");
+        return e_failure;
+    }
+    if(opts->password != NULL || opts->ecc || opts->chunk_size || opts->matrix_k)
+    {
+        printf("ERROR: -k, -r, -c and -m are not supported in frame stream mode\n");
+        return e_failure;
+    }
+    return parse_frame_geometry(opts->geometry, geo);
+}
+
+//to embed sequence header and payload into pixels of one frame
+static void embed_frame(char *pixels, uint seq, char flags, const char *data, uint len)
+{
+    const char *magic = STREAM_FRAME_MAGIC;
+    encode_byte_to_lsb(magic[0], pixels);
+    encode_byte_to_lsb(magic[1], pixels + 8);
+    encode_byte_to_lsb(flags, pixels + 16);
+    encode_uint_to_lsb(seq, pixels + 24);
+    encode_uint_to_lsb(len, pixels + 56);
+    pixels += STREAM_HEADER_BYTES * 8;
+    for(uint i = 0; i < len; i++)
+    {
+        encode_byte_to_lsb(data[i], pixels + 8 * i);
+    }
+}
+
+/*
+ * Encode secret file over frames of input stream
+ * Input: argv[2] input stream, argv[3] secret file, argv[4] output stream
+ * Return Value: e_failure if stream ends before whole secret is embedded
+ */
+Status do_stream_encoding(char *argv[], int argc, const StegoOptions *opts)
+{
+    FrameGeometry geo;
+    if(argc != 5)
+    {
+        printf("ERROR: Usage: -fe <input stream> <secret> <output stream> -g <geometry>\n");
+        return e_failure;
+    }
+    if(read_stream_options(opts, &geo) == e_failure)
+    {
+        return e_failure;
+    }
+
+    int fd_in = open_input_stream(argv[2]);
+    FILE *fptr_secret = fopen(argv[3], "r");
+    FILE *fptr_out = fopen(argv[4], "w");
+    char *payload = malloc(geo.capacity);
+    FrameQueue q;
+    if(fd_in < 0 || fptr_secret == NULL || fptr_out == NULL || payload == NULL || frame_queue_start(&q, fd_in, geo.frame_size) == e_failure)
+    {
+        if(fptr_secret == NULL || fptr_out == NULL)
+        {
+            perror("fopen");
+            fprintf(stderr, "ERROR: Unable to open file %s or %s\n", argv[3], argv[4]);
+        }
+        if(fd_in > STDIN_FILENO)
+        {
+            close(fd_in);
+        }
+        if(fptr_secret != NULL)
+        {
+            fclose(fptr_secret);
+        }
+        if(fptr_out != NULL)
+        {
+            fclose(fptr_out);
+        }
+        free(payload);
+        return e_failure;
+    }
+
+    printf("INFO: ## Stream Encoding Procedure Started ##\n");
+    printf("INFO: %u byte frames, %u payload bytes per frame\n", geo.frame_size, geo.capacity);
+    Status status = e_success;
+    uint seq = 0;
+    uint frames = 0;
+    unsigned long embedded = 0;
+    int finished = 0;
+    char *frame;
+    while(status == e_success && (frame = frame_queue_get(&q)) != NULL)
+    {
+        if(!finished)
+        {
+            //secret may be a pipe too, end is known only after a short read or EOF peek
+            uint len = fread(payload, 1, geo.capacity, fptr_secret);
+            int ch = (len == geo.capacity) ? fgetc(fptr_secret) : EOF;
+            if(ch != EOF)
+            {
+                ungetc(ch, fptr_secret);
+            }
+            else
+            {
+                finished = 1;
+            }
+            embed_frame(frame + geo.header_size, seq++, finished ? STREAM_FRAME_LAST : 0, payload, len);
+            embedded += len;
+        }
+        if(fwrite(frame, 1, geo.frame_size, fptr_out) != geo.frame_size)
+        {
+            printf("Error while writing frame\n");
+            status = e_failure;
+        }
+        frames++;
+        frame_queue_release(&q);
+    }
+    if(frame_queue_stop(&q) == e_failure)
+    {
+        status = e_failure;
+    }
+
+    if(status == e_success && !finished)
+    {
+        printf("ERROR: Stream ended after %u frames, only %lu bytes of %s were embedded\n", frames, embedded, argv[3]);
+        status = e_failure;
+    }
+    if(fclose(fptr_out) != 0)
+    {
+        status = e_failure;
+    }
+    if(fd_in != STDIN_FILENO)
+    {
+        close(fd_in);
+    }
+    fclose(fptr_secret);
+    free(payload);
+    if(status == e_success)
+    {
+        printf("INFO: Embedded %lu bytes in %u of %u frames\n", embedded, seq, frames);
+        printf("INFO: ## Stream Encoding Done Successfully ##\n");
+    }
+    return status;
+}
+
+//to check and decode sequence header of one frame
+static Status extract_frame_header(char *pixels, uint expected_seq, uint capacity, char *flags, uint *len)
+{
+    const char *magic = STREAM_FRAME_MAGIC;
+    if(decode_byte_from_lsb(pixels) != magic[0] || decode_byte_from_lsb(pixels + 8) != magic[1])
+    {
+        printf("ERROR: Frame %u has no stream header\n", expected_seq);
+        return e_failure;
+    }
+    *flags = decode_byte_from_lsb(pixels + 16);
+    uint seq = decode_uint_from_lsb(pixels + 24);
+    *len = decode_uint_from_lsb(pixels + 56);
+    if(seq != expected_seq)
+    {
+        printf("ERROR: Expected frame %u, got frame %u, frames were dropped or reordered\n", expected_seq, seq);
+        return e_failure;
+    }
+    if(*len > capacity)
+    {
+        printf("ERROR: Frame %u payload length %u is more than frame capacity %u\n", seq, *len, capacity);
+        return e_failure;
+    }
+    return e_success;
+}
+
+/*
+ * Decode secret file from frames of input stream
+ * Input: argv[2] input stream, argv[3] output file
+ * Description: frames are read until the frame marked last,
+ * payload of each frame is written as soon as it is extracted.
+ * Output is closed and the reader stopped right after the last frame,
+ * the input pipe does not need to be closed by the producer.
+ */
+Status do_stream_decoding(char *argv[], int argc, const StegoOptions *opts)
+{
+    FrameGeometry geo;
+    if(argc != 4)
+    {
+        printf("ERROR: Usage: -fd <input stream> <output file> -g <geometry>\n");
+        return e_failure;
+    }
+    if(read_stream_options(opts, &geo) == e_failure)
+    {
+        return e_failure;
+    }
+
+    int fd_in = open_input_stream(argv[2]);
+    FILE *fptr_out = fopen(argv[3], "w");
+    char *payload = malloc(geo.capacity);
+    FrameQueue q;
+    if(fd_in < 0 || fptr_out == NULL || payload == NULL || frame_queue_start(&q, fd_in, geo.frame_size) == e_failure)
+    {
+        if(fptr_out == NULL)
+        {
+            perror("fopen");
+            fprintf(stderr, "ERROR: Unable to open file %s\n", argv[3]);
+        }
+        if(fd_in > STDIN_FILENO)
+        {
+            close(fd_in);
+        }
+        if(fptr_out != NULL)
+        {
+            fclose(fptr_out);
+        }
+        free(payload);
+        return e_failure;
+    }
+
+    printf("INFO: ## Stream Decoding Procedure Started ##\n");
+    Status status = e_success;
+    uint seq = 0;
+    unsigned long extracted = 0;
+    int finished = 0;
+    char *frame;
+    while(status == e_success && !finished && (frame = frame_queue_get(&q)) != NULL)
+    {
+        char *pixels = frame + geo.header_size;
+        char flags;
+        uint len;
+        status = extract_frame_header(pixels, seq, geo.capacity, &flags, &len);
+        if(status == e_success)
+        {
+            pixels += STREAM_HEADER_BYTES * 8;
+            for(uint i = 0; i < len; i++)
+            {
+                payload[i] = decode_byte_from_lsb(pixels + 8 * i);
+            }
+            if(fwrite(payload, 1, len, fptr_out) != len)
+            {
+                printf("Error while writing secret data\n");
+                status = e_failure;
+            }
+            extracted += len;
+            finished = flags & STREAM_FRAME_LAST;
+            seq++;
+        }
+        frame_queue_release(&q);
+    }
+    //secret is complete once the last frame is extracted, flush it before stopping reader
+    if(fclose(fptr_out) != 0)
+    {
+        printf("Error while writing secret data\n");
+        status = e_failure;
+    }
+    if(frame_queue_stop(&q) == e_failure && !finished)
+    {
+        status = e_failure;
+    }
+
+    if(status == e_success && !finished)
+    {
+        printf("ERROR: Stream ended after %u frames before the last payload frame\n", seq);
+        status = e_failure;
+    }
+    if(fd_in != STDIN_FILENO)
+    {
+        close(fd_in);
+    }
+    free(payload);
+    if(status == e_success)
+    {
+        printf("INFO: Reassembled %lu bytes from %u frames into %s\n", extracted, seq, argv[3]);
+        printf("INFO: ## Stream Decoding Done Successfully ##\n");
+    }
+    return status;
+}
@@ -0,0 +1,59 @@
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdio.h>
+#include <pthread.h>
+#include "types.h" // Contains user defined types
+
+/* Frames read ahead while the current frame is embedded (double buffer) */
+#define STREAM_BUFFERS 2
+
+/* Per frame sequence header: magic (2), flags (1), sequence int, length int */
+#define STREAM_HEADER_BYTES 11
+
+/*
+ * Geometry of every frame in the stream, given once with
+ * -g <width>x<height>x<bytes per pixel>[+<header bytes>]
+ * Header bytes (e.g. a BMP header repeated per frame) are copied as is.
+ */
+typedef struct _FrameGeometry
+{
+    uint width;
+    uint height;
+    uint bpp;            //bytes per pixel
+    uint header_size;   //bytes before pixels in every frame
+    uint pixel_size;   //width * height * bpp
+    uint frame_size;  //header_size + pixel_size
+    uint capacity;   //payload bytes per frame after sequence header
+
+} FrameGeometry;
+
+/* Frames read by reader thread, handed to embed / extract loop in order */
+typedef struct _FrameQueue
+{
+    int fd;             //input stream, read with read(2)
+    int wake[2];       //pipe written by frame_queue_stop to wake reader from poll
+    uint frame_size;
+    char *frames[STREAM_BUFFERS];
+    int head;        //next frame for embed / extract loop
+    int count;      //frames read and not yet released
+    int eof;       //stream ended on frame boundary
+    int error;    //read error or partial frame
+    int stop;    //embed / extract loop gave up, reader exits
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    pthread_cond_t space;
+    pthread_t reader;
+
+} FrameQueue;
+
+/* Parse -g geometry string */
+Status parse_frame_geometry(const char *str, FrameGeometry *geo);
+
+/* Spread secret file over consecutive frames of input stream */
+Status do_stream_encoding(char *argv[], int argc, const StegoOptions *opts);
+
+/* Reassemble secret file from frame stream */
+Status do_stream_decoding(char *argv[], int argc, const StegoOptions *opts);
+
+#endif
@@ -0,0 +1,40 @@
+# Helpers for CLI tests, sourced by tests/test_*.sh
+# STEGO is the binary under test, ASSETS the repository root with beautiful.bmp and secret.txt
+# stego prints INFO / ERROR lines and does not set an exit status, so output is checked
+
+passed=0
+failed=0
+
+#to run command, output must contain expected text: check <name> <expected text> <command...>
+check()
+{
+    local name=$1 expected=$2
+    shift 2
+    local out
+    out=$("$@" 2>&1)
+    if printf '%s\n' "$out" | grep -qF -- "$expected"; then
+        passed=$((passed + 1))
+    else
+        failed=$((failed + 1))
+        echo "FAIL: $name, expected \"$expected\""
+        printf '%s\n' "$out" | tail -5 | sed 's/^/    /'
+    fi
+}
+
+#to compare two files: check_same <name> <file> <file>
+check_same()
+{
+    if cmp -s "$2" "$3"; then
+        passed=$((passed + 1))
+    else
+        failed=$((failed + 1))
+        echo "FAIL: $1, $2 and $3 differ"
+    fi
+}
+
+#to print summary, status for end of test script
+finish()
+{
+    echo "$(basename "$0"): $((passed + failed)) checks, $failed failed"
+    [ $failed -eq 0 ]
+}
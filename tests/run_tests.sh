@@ -0,0 +1,37 @@
+#!/bin/bash
+# Build stego and run every tests/test_*.c unit test and tests/test_*.sh CLI test
+# Usage: tests/run_tests.sh [module ...]   e.g. tests/run_tests.sh cipher rs
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+CC=${CC:-gcc}
+CFLAGS="-Wall -O2"
+SOURCES=()
+for src in "$ROOT"/*.c; do
+    [ "$(basename "$src")" = main.c ] || SOURCES+=("$src")   #unit tests have their own main
+done
+
+$CC $CFLAGS "$ROOT"/*.c -o "$WORK/stego" -pthread -lm || exit 1
+failed=0
+for test in "$ROOT"/tests/test_*.c "$ROOT"/tests/test_*.sh; do
+    name=$(basename "$test")
+    module=${name#test_}
+    module=${module%.*}
+    if [ $# -gt 0 ] && ! printf '%s\n' "$@" | grep -qx "$module"; then
+        continue
+    fi
+    dir="$WORK/${name/./_}"   #every test runs in its own empty directory
+    mkdir "$dir"
+    case $name in
+        *.c) $CC $CFLAGS -I"$ROOT" "$test" "${SOURCES[@]}" -o "$dir/test" -pthread -lm && (cd "$dir" && ./test) ;;
+        *.sh) (cd "$dir" && STEGO="$WORK/stego" ASSETS="$ROOT" bash "$test") ;;
+    esac
+    if [ $? -ne 0 ]; then
+        failed=$((failed + 1))
+    fi
+done
+if [ $failed -ne 0 ]; then
+    echo "$failed test files failed"
+    exit 1
+fi
+echo "All tests passed"
@@ -0,0 +1,86 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Unit tests of analyze.c, chi-square and RS estimate on known
+              histograms, and failure of the analysis when a worker can
+              not allocate its buffers.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "analyze.h"
+#include "unit.h"
+
+extern void *__libc_malloc(size_t size);
+
+static size_t fail_size = 0;   //malloc of this many bytes returns NULL
+
+//to let one allocation size fail, everything else goes to glibc
+void *malloc(size_t size)
+{
+    if(fail_size != 0 && size == fail_size)
+    {
+        return NULL;
+    }
+    return __libc_malloc(size);
+}
+
+//equal pair counts look embedded, one sided counts do not
+static void test_chi_square(void)
+{
+    unsigned long hist[256] = {0};
+    double chi2;
+    int df;
+    for(int v = 0; v < 256; v++)
+    {
+        hist[v] = 1000;
+    }
+    CHECK(chi_square_pov(hist, &chi2, &df) > 0.99);
+    CHECK(df == 127);
+    for(int v = 0; v < 256; v += 2)
+    {
+        hist[v] = 2000;
+        hist[v + 1] = 0;
+    }
+    CHECK(chi_square_pov(hist, &chi2, &df) < 0.01);
+}
+
+//to write a small grayscale image
+static int write_pgm(const char *fname)
+{
+    FILE *fptr = fopen(fname, "w");
+    if(fptr == NULL)
+    {
+        return 0;
+    }
+    fprintf(fptr, "P5\n64 64\n255\n");
+    for(int i = 0; i < 64 * 64; i++)
+    {
+        fputc((i * 7) & 0xfe, fptr);
+    }
+    fclose(fptr);
+    return 1;
+}
+
+//worker without split counters fails the analysis instead of leaving tiles empty
+static void test_worker_malloc_failure(void)
+{
+    StegoOptions opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.threads = 2;
+    CHECK(write_pgm("small.pgm"));
+    CHECK(do_analyze("small.pgm", &opts) == e_success);
+    fail_size = sizeof(uint) * ANALYZE_SPLIT_COUNTERS * ANALYZE_MAX_CHANNELS * 256;
+    CHECK(do_analyze("small.pgm", &opts) == e_failure);
+    fail_size = 0;
+    remove("small.pgm");
+}
+
+int main(void)
+{
+    test_chi_square();
+    test_worker_malloc_failure();
+    return UNIT_DONE("test_analyze");
+}
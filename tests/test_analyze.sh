@@ -0,0 +1,18 @@
+# CLI tests of steganalysis (-a)
+source "$(dirname "$0")/lib.sh"
+
+#grayscale cover with only even values, the LSB plane is empty before embedding
+{ printf 'P5\n512 512\n255\n'; perl -e 'srand(1); for $y (0..511) { for $x (0..511) { print chr((($x * 3 + $y * 5 + int(rand(6))) * 2) % 256) } }'; } > even.pgm
+perl -e 'srand(2); print map { chr(int(rand(256))) } 1..28000' > payload.txt   #uniform bytes, about 85% of capacity
+$STEGO -e even.pgm payload.txt stego.pgm > /dev/null
+
+check "clean cover" "No sequential LSB embedding detected" $STEGO -a even.pgm
+check "embedded cover" "Sequential LSB embedding detected in about the first 80%" $STEGO -a stego.pgm
+
+#statistics do not depend on how rows are split between threads
+$STEGO -a stego.pgm -t 1 | grep -v "threads\|took" > one.txt
+$STEGO -a stego.pgm -t 7 | grep -v "threads\|took" > seven.txt
+check_same "same result with 1 and 7 threads" one.txt seven.txt
+check "BMP analysis" "Analysis Done" $STEGO -a $ASSETS/beautiful.bmp
+check "missing image" "Unable to open file" $STEGO -a nothing.bmp
+finish
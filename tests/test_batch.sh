@@ -0,0 +1,18 @@
+# CLI tests of batch mode, more jobs than queue slots and failing jobs
+source "$(dirname "$0")/lib.sh"
+
+for i in 1 2 3 4 5 6; do
+    cp $ASSETS/beautiful.bmp c$i.bmp
+    echo "-e c$i.bmp $ASSETS/secret.txt s$i.bmp" >> encode.txt
+    echo "-d s$i.bmp out$i" >> decode.txt
+done
+echo "-e missing.bmp $ASSETS/secret.txt s7.bmp" >> encode.txt
+echo "-x c1.bmp" >> encode.txt
+
+check "batch encode" "Batch Done, 6 jobs succeeded, 2 failed" $STEGO -b encode.txt -q 2 -n 3
+check "batch decode" "Batch Done, 6 jobs succeeded, 0 failed" $STEGO -b decode.txt -q 4
+for i in 1 2 3 4 5 6; do
+    check_same "batch round trip $i" out$i.txt $ASSETS/secret.txt
+done
+check "missing job list" "Unable to open file" $STEGO -b nothing.txt
+finish
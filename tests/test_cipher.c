@@ -0,0 +1,112 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Unit tests of cipher.c, SHA-256, PBKDF2-HMAC-SHA256 and ChaCha20
+              against published test vectors, and key derivation from
+              password, nonce and salt.
+*/
+
+#include <string.h>
+#include "cipher.h"
+#include "unit.h"
+
+//to compare len bytes with a hex string
+static int same_hex(const unsigned char *bytes, const char *hex, int len)
+{
+    for(int i = 0; i < len; i++)
+    {
+        unsigned int value;
+        if(sscanf(hex + 2 * i, "%2x", &value) != 1 || bytes[i] != value)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+//FIPS 180-2 appendix B.1 SHA-256 of "abc", and of 1000 bytes crossing block boundaries
+static void test_sha256_vector(void)
+{
+    unsigned char digest[32], data[1000];
+    cipher_sha256((const unsigned char *)"abc", 3, digest);
+    CHECK(same_hex(digest, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", 32));
+    memset(data, 'a', sizeof(data));
+    cipher_sha256(data, sizeof(data), digest);
+    CHECK(same_hex(digest, "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3", 32));
+}
+
+//RFC 7914 section 11, PBKDF2-HMAC-SHA256 P = "passwd", S = "salt", c = 1
+static void test_pbkdf2_vector(void)
+{
+    unsigned char key[64];
+    cipher_pbkdf2_sha256((const unsigned char *)"passwd", 6, (const unsigned char *)"salt", 4, 1, key, sizeof(key));
+    CHECK(same_hex(key, "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+                        "49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783", 64));
+}
+
+//RFC 8439 section 2.3.2, ChaCha20 block of key 00..1f, counter 1
+static void test_chacha20_vector(void)
+{
+    CipherInfo cipher;
+    unsigned char key[32];
+    unsigned char nonce[CIPHER_NONCE_SIZE] = {0, 0, 0, 0x09, 0, 0, 0, 0x4a, 0, 0, 0, 0};
+    for(int i = 0; i < 32; i++)
+    {
+        key[i] = i;
+    }
+    cipher.state[0] = 0x61707865;
+    cipher.state[1] = 0x3320646e;
+    cipher.state[2] = 0x79622d32;
+    cipher.state[3] = 0x6b206574;
+    for(int i = 0; i < 8; i++)
+    {
+        cipher.state[4 + i] = key[4 * i] | (key[4 * i + 1] << 8) | (key[4 * i + 2] << 16) | ((uint)key[4 * i + 3] << 24);
+    }
+    cipher.state[12] = 1;
+    for(int i = 0; i < 3; i++)
+    {
+        cipher.state[13 + i] = nonce[4 * i] | (nonce[4 * i + 1] << 8) | (nonce[4 * i + 2] << 16) | ((uint)nonce[4 * i + 3] << 24);
+    }
+    cipher_next_block(&cipher);
+    CHECK(same_hex(cipher.keystream, "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+                                     "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e", 64));
+    CHECK(cipher.state[12] == 2);
+}
+
+//same password, nonce and salt give the same keystream, another salt or password does not
+static void test_key_derivation(void)
+{
+    unsigned char nonce[CIPHER_NONCE_SIZE], salt[CIPHER_SALT_SIZE], other_salt[CIPHER_SALT_SIZE];
+    CHECK(cipher_generate_nonce(nonce, salt) == e_success);
+    memcpy(other_salt, salt, sizeof(salt));
+    other_salt[0] ^= 1;
+
+    CipherInfo a, b, c, d;
+    CHECK(cipher_init(&a, "secret", nonce, salt) == e_success);
+    CHECK(cipher_init(&b, "secret", nonce, salt) == e_success);
+    CHECK(cipher_init(&c, "secret", nonce, other_salt) == e_success);
+    CHECK(cipher_init(&d, "Secret", nonce, salt) == e_success);
+    char ka[100], kb[100], kc[100], kd[100];
+    for(int i = 0; i < 100; i++)
+    {
+        ka[i] = cipher_next_byte(&a);
+        kb[i] = cipher_next_byte(&b);
+        kc[i] = cipher_next_byte(&c);
+        kd[i] = cipher_next_byte(&d);
+    }
+    CHECK(memcmp(ka, kb, sizeof(ka)) == 0);
+    CHECK(memcmp(ka, kc, sizeof(ka)) != 0);
+    CHECK(memcmp(ka, kd, sizeof(ka)) != 0);
+    CHECK(cipher_init(&a, "", nonce, salt) == e_failure);
+}
+
+int main(void)
+{
+    test_sha256_vector();
+    test_pbkdf2_vector();
+    test_chacha20_vector();
+    test_key_derivation();
+    return UNIT_DONE("test_cipher");
+}
@@ -0,0 +1,20 @@
+# CLI tests of encryption (-k)
+source "$(dirname "$0")/lib.sh"
+
+check "encrypted encode" "Encoding Done Successfully" $STEGO -e $ASSETS/beautiful.bmp $ASSETS/secret.txt k.bmp -k pass
+check "encrypted decode" "Decoding Done Successfully" $STEGO -d k.bmp out -k pass
+check_same "encrypted round trip" out.txt $ASSETS/secret.txt
+check "decode without password" "is encrypted, pass the password with -k" $STEGO -d k.bmp nopass
+$STEGO -d k.bmp wrong -k other > /dev/null 2>&1
+if cmp -s wrong.txt $ASSETS/secret.txt; then
+    failed=$((failed + 1))
+    echo "FAIL: wrong password recovered the secret"
+fi
+
+#salt and nonce are random, two encodings of the same secret differ
+$STEGO -e $ASSETS/beautiful.bmp $ASSETS/secret.txt k2.bmp -k pass > /dev/null
+if cmp -s k.bmp k2.bmp; then
+    failed=$((failed + 1))
+    echo "FAIL: two encryptions with the same password are equal"
+fi
+finish
@@ -0,0 +1,59 @@
+# CLI tests of coordinator / worker mode, lease fencing and job journal
+source "$(dirname "$0")/lib.sh"
+
+cp $ASSETS/beautiful.bmp c1.bmp
+cp $ASSETS/beautiful.bmp c2.bmp
+printf -- '-e c1.bmp %s s1.bmp\n-e c2.bmp %s s2.bmp\n-d s1.bmp d1\n' $ASSETS/secret.txt $ASSETS/secret.txt > jobs.txt   #one worker runs jobs in order
+
+stdbuf -oL $STEGO -C jobs.txt $PWD/c.sock -l 2 > coordinator.log 2>&1 &
+coordinator=$!
+trap 'kill $coordinator 2> /dev/null' EXIT
+for i in 1 2 3 4 5 6 7 8 9 10; do
+    [ -S c.sock ] && break
+    sleep 0.2
+done
+
+#worker A leases a job, B is not the holder, A sends a wrong generation and then lets the lease expire,
+#then A leases it again and stalls after COMMIT, the committing lease expires too
+cat > fake.pl <<'PERL'
+use IO::Socket::UNIX;
+my $a = IO::Socket::UNIX->new(Peer => $ARGV[0]) or die;
+my $b = IO::Socket::UNIX->new(Peer => $ARGV[0]) or die;
+print $a "GET\n";
+my ($id, $gen) = (<$a> =~ /^JOB (\d+) (\d+) /) or die;
+print $b "OK $id $gen\n";
+print "not holder: ", scalar <$b>;
+print $a "OK $id ", $gen + 1, "\n";
+print "wrong generation: ", scalar <$a>;
+sleep 4;
+print $a "OK $id $gen\n";
+print "expired lease: ", scalar <$a>;
+print $b "COMMITTED $id $gen\nFAIL $id $gen\n";
+print $a "GET\n";
+($id, $gen) = (<$a> =~ /^JOB (\d+) (\d+) /) or die;
+print $a "OK $id $gen\n";
+print "commit: ", scalar <$a>;
+sleep 4;
+print $a "COMMITTED $id $gen\n";
+PERL
+perl fake.pl $PWD/c.sock > fake.log
+check "OK from a worker not holding the lease" "not holder: STALE 0" cat fake.log
+check "OK with a wrong generation" "wrong generation: STALE 0" cat fake.log
+check "OK after the lease expired" "expired lease: STALE 0" cat fake.log
+check "expired job queued again" "Job 0 queued again" cat coordinator.log
+check "COMMIT to the holder" "commit: COMMIT 0" cat fake.log
+check "committing lease expires" "2" sh -c 'grep -c "Lease of job 0 expired" coordinator.log'
+
+check "worker runs every job" "Worker Done, 3 jobs succeeded, 0 failed" $STEGO -W $PWD/c.sock
+wait $coordinator
+check "coordinator done" "Coordinator Done, 3 jobs succeeded, 0 failed" cat coordinator.log
+$STEGO -e $ASSETS/beautiful.bmp $ASSETS/secret.txt local.bmp > /dev/null
+check_same "job output 1" s1.bmp local.bmp
+check_same "job output 2" s2.bmp local.bmp
+check_same "decode job output" d1.txt $ASSETS/secret.txt
+check "no temp files left" "none" sh -c 'ls *.tmp 2> /dev/null || echo none'
+check "journal" "2 -d s1.bmp d1" cat jobs.txt.done
+
+#restarted coordinator skips journaled jobs
+check "resume from journal" "3 jobs, 3 already done" $STEGO -C jobs.txt $PWD/c.sock
+finish
@@ -0,0 +1,30 @@
+# CLI tests of daemon mode, round trips through the socket and idle clients
+source "$(dirname "$0")/lib.sh"
+
+stdbuf -oL $STEGO -D $PWD/d.sock -t 1 > daemon.log 2>&1 &   #line buffered so the log can be checked while it runs
+daemon=$!
+trap 'kill $daemon 2> /dev/null' EXIT
+for i in 1 2 3 4 5 6 7 8 9 10; do
+    [ -S d.sock ] && break
+    sleep 0.2
+done
+
+check "daemon encode" "Encoding Done Successfully by Daemon" $STEGO -e $ASSETS/beautiful.bmp $ASSETS/secret.txt d.bmp -s $PWD/d.sock
+$STEGO -e $ASSETS/beautiful.bmp $ASSETS/secret.txt local.bmp > /dev/null
+check_same "daemon and local encode" d.bmp local.bmp
+check "daemon decode" "Decoding Done Successfully by Daemon" $STEGO -d d.bmp out -s $PWD/d.sock
+check_same "daemon round trip" out.txt $ASSETS/secret.txt
+
+seq 1 600 > big.txt
+check "daemon encode -k -r" "Encoding Done Successfully by Daemon" $STEGO -e $ASSETS/beautiful.bmp big.txt kr.bmp -k pass -r -s $PWD/d.sock
+check "daemon decode -k" "Decoding Done Successfully by Daemon" $STEGO -d kr.bmp kr -k pass -s $PWD/d.sock
+check_same "daemon round trip -k -r" kr.txt big.txt
+
+#client which never sends a request must not hold the only worker forever
+perl -MIO::Socket::UNIX -e '$s = IO::Socket::UNIX->new(Peer => $ARGV[0]) or exit 1; sleep 15' $PWD/d.sock &
+idle=$!
+sleep 0.5
+check "request after idle client" "Encoding Done Successfully by Daemon" timeout 12 $STEGO -e $ASSETS/beautiful.bmp $ASSETS/secret.txt d2.bmp -s $PWD/d.sock
+kill $idle 2> /dev/null
+check "idle client closed" "Closing client without a complete request" cat daemon.log
+finish
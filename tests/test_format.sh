@@ -0,0 +1,72 @@
+# CLI tests of cover format backends, round trips and crafted headers
+source "$(dirname "$0")/lib.sh"
+
+#to write little endian values
+le16()
+{
+    printf "$(printf '\\%03o\\%03o' $(($1 & 255)) $(($1 >> 8 & 255)))"
+}
+le32()
+{
+    printf "$(printf '\\%03o\\%03o\\%03o\\%03o' $(($1 & 255)) $(($1 >> 8 & 255)) $(($1 >> 16 & 255)) $(($1 >> 24 & 255)))"
+}
+
+#to write 54 byte BMP header: bmp_header <width> <height> <bpp> <pixel offset>
+bmp_header()
+{
+    printf 'BM'; le32 0; le32 0; le32 $4
+    le32 40; le32 $1; le32 $2; le16 1; le16 $3
+    le32 0; le32 0; le32 0; le32 0; le32 0; le32 0
+}
+
+#to write 18 byte TGA header: tga_header <type> <width> <height> <bpp>
+tga_header()
+{
+    printf '\000\000'; printf "$(printf '\\%03o' $1)"
+    le16 0; le16 0; printf '\000'
+    le16 0; le16 0; le16 $2; le16 $3
+    printf "$(printf '\\%03o' $4)"; printf '\000'
+}
+
+#pixel bytes from the sample image
+pixels()
+{
+    dd if=$ASSETS/beautiful.bmp bs=1024 skip=1 count=$((($1 + 1023) / 1024)) 2> /dev/null | head -c $1
+}
+
+#round trips of every backend
+{ printf 'P6\n# comment\n64 64\n255\n'; pixels $((64 * 64 * 3)); } > c.ppm
+{ printf 'P5\n64 64\n255\n'; pixels $((64 * 64)); } > c.pgm
+{ tga_header 2 64 64 24; pixels $((64 * 64 * 3)); } > c24.tga
+{ tga_header 2 64 64 32; pixels $((64 * 64 * 4)); } > c32.tga
+{ tga_header 3 64 64 8; pixels $((64 * 64)); } > c8.tga
+{ bmp_header 63 -64 24 54; pixels $((64 * 64 * 3)); } > top_down.bmp   #rows padded to 192 bytes
+for cover in c.ppm c.pgm c24.tga c32.tga c8.tga top_down.bmp; do
+    check "$cover encode" "Encoding Done Successfully" $STEGO -e $cover $ASSETS/secret.txt s_$cover
+    check "$cover decode" "Decoding Done Successfully" $STEGO -d s_$cover out_$cover
+    check_same "$cover round trip" out_$cover.txt $ASSETS/secret.txt
+done
+
+#crafted headers are rejected before any pixel is touched
+{ bmp_header 1431655766 10 24 54; pixels 4096; } > wide.bmp
+{ bmp_header 0 64 24 54; pixels 4096; } > zero.bmp
+{ bmp_header 10 -2147483648 24 54; pixels 4096; } > int_min.bmp
+{ bmp_header 64 64 24 10; pixels $((64 * 64 * 3)); } > offset.bmp
+{ bmp_header 64 64 24 54; pixels 1000; } > truncated.bmp
+{ bmp_header 64 64 16 54; pixels $((64 * 64 * 2)); } > depth.bmp
+{ tga_header 2 64 64 16; pixels $((64 * 64 * 2)); } > c16.tga
+{ printf 'P6\n100000 100000\n255\n'; pixels 4096; } > huge.ppm
+{ printf 'P6\n99999999999 1\n255\n'; pixels 4096; } > overflow.ppm
+{ printf 'P6\n64 64\n65535\n'; pixels 4096; } > deep.ppm
+check "huge BMP width" "is too large" $STEGO -e wide.bmp $ASSETS/secret.txt o1.bmp
+check "zero BMP width" "has zero width or height" $STEGO -e zero.bmp $ASSETS/secret.txt o2.bmp
+check "INT_MIN BMP height" "is too large" $STEGO -e int_min.bmp $ASSETS/secret.txt o3.bmp
+check "BMP offset inside header" "is inside the header" $STEGO -e offset.bmp $ASSETS/secret.txt o4.bmp
+check "truncated BMP" "pixel data is truncated" $STEGO -e truncated.bmp $ASSETS/secret.txt o5.bmp
+check "16 bit BMP" "Only uncompressed 24/32 bit BMP is supported" $STEGO -e depth.bmp $ASSETS/secret.txt o6.bmp
+check "16 bit TGA" "Unsupported TGA depth 16 bit" $STEGO -e c16.tga $ASSETS/secret.txt o7.tga
+check "huge PPM" "is too large" $STEGO -e huge.ppm $ASSETS/secret.txt o8.ppm
+check "overflowing PPM width" "Invalid PPM/PGM header" $STEGO -e overflow.ppm $ASSETS/secret.txt o9.ppm
+check "16 bit PPM" "Only 8 bit PPM/PGM is supported" $STEGO -e deep.ppm $ASSETS/secret.txt o10.ppm
+check "crafted BMP analysis" "is too large" $STEGO -a wide.bmp
+finish
@@ -0,0 +1,137 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Unit tests of ioengine.c, batched reads through io_uring and
+              the blocking fallback, and requests failed at submit when
+              io_uring_enter is refused.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ioengine.h"
+#include "unit.h"
+
+#define READS 6
+#define READ_SIZE 512
+
+static char file_data[READS * READ_SIZE];
+
+//to create the file read by the tests
+static int make_file(void)
+{
+    for(uint i = 0; i < sizeof(file_data); i++)
+    {
+        file_data[i] = i * 7 + i / 251;
+    }
+    int fd = open("io.bin", O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0 || write(fd, file_data, sizeof(file_data)) != (ssize_t)sizeof(file_data))
+    {
+        return -1;
+    }
+    return fd;
+}
+
+//READS reads and one read of a bad fd are queued, then all are reaped
+static void test_reads(IoEngine *io, int fd)
+{
+    static char buffers[READS][READ_SIZE];
+    memset(buffers, 0, sizeof(buffers));
+    for(int i = 0; i < READS; i++)
+    {
+        CHECK(io_submit_read(io, fd, buffers[i], READ_SIZE, (long)i * READ_SIZE, i) == e_success);
+    }
+    CHECK(io_submit_read(io, -1, buffers[0], READ_SIZE, 0, READS) == e_success);
+    CHECK(io->in_flight == READS + 1);
+
+    int seen[READS + 1] = {0};
+    IoCompletion completion;
+    for(int i = 0; i <= READS; i++)
+    {
+        CHECK(io_wait_completion(io, &completion) == e_success);
+        CHECK(completion.tag <= READS);
+        if(completion.tag > READS)
+        {
+            continue;
+        }
+        seen[completion.tag]++;
+        if(completion.tag == READS)
+        {
+            CHECK(completion.result == -EBADF);
+        }
+        else
+        {
+            CHECK(completion.result == READ_SIZE);
+        }
+    }
+    for(int i = 0; i < READS; i++)
+    {
+        CHECK(seen[i] == 1);
+        CHECK(memcmp(buffers[i], file_data + i * READ_SIZE, READ_SIZE) == 0);
+    }
+    CHECK(io->in_flight == 0);
+    CHECK(io->queued == 0);
+    CHECK(io_wait_completion(io, &completion) == e_failure);   //nothing in flight
+}
+
+//refused io_uring_enter fails the queued requests, later requests still work
+static void test_refused_enter(IoEngine *io, int fd)
+{
+    char buffer[READ_SIZE];
+    int ring_fd = io->ring_fd;
+    io->ring_fd = -1;   //io_uring_enter fails with EBADF
+    CHECK(io_submit_read(io, fd, buffer, READ_SIZE, 0, 11) == e_success);
+    CHECK(io_submit_read(io, fd, buffer, READ_SIZE, 0, 12) == e_success);
+    IoCompletion a, b;
+    CHECK(io_wait_completion(io, &a) == e_success);
+    CHECK(io_wait_completion(io, &b) == e_success);
+    CHECK(a.tag == 11 && a.result == -EBADF);
+    CHECK(b.tag == 12 && b.result == -EBADF);
+    CHECK(io->in_flight == 0);
+    io->ring_fd = ring_fd;
+
+    //taken back entries must not reach the kernel with the next submit
+    CHECK(io_submit_read(io, fd, buffer, READ_SIZE, READ_SIZE, 13) == e_success);
+    CHECK(io_wait_completion(io, &a) == e_success);
+    CHECK(a.tag == 13 && a.result == READ_SIZE);
+    CHECK(memcmp(buffer, file_data + READ_SIZE, READ_SIZE) == 0);
+    CHECK(io->in_flight == 0);
+    CHECK(io_wait_completion(io, &a) == e_failure);
+}
+
+int main(void)
+{
+    int fd = make_file();
+    CHECK(fd >= 0);
+    IoEngine io;
+    CHECK(io_engine_init(&io, 8) == e_success);
+
+    char buffer[READ_SIZE];
+    for(int i = 0; i < 8; i++)
+    {
+        io_submit_read(&io, fd, buffer, READ_SIZE, 0, i);
+    }
+    CHECK(io_submit_read(&io, fd, buffer, READ_SIZE, 0, 8) == e_failure);   //queue is full
+    IoCompletion completion;
+    while(io_wait_completion(&io, &completion) == e_success);
+
+    if(io.use_uring)
+    {
+        test_reads(&io, fd);
+        test_refused_enter(&io, fd);
+    }
+    else
+    {
+        printf("test_ioengine: io_uring not available, blocking fallback only\n");
+    }
+    io_engine_close(&io);   //engine goes on with blocking pread / pwrite
+    test_reads(&io, fd);
+
+    close(fd);
+    unlink("io.bin");
+    return UNIT_DONE("test_ioengine");
+}
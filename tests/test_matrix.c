@@ -0,0 +1,89 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Unit tests of matrix.c, Hamming matrix embedding round trip
+              for every k and at most one changed cover byte per group.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "matrix.h"
+#include "unit.h"
+
+//to fill data with a fixed pseudo random sequence
+static void fill(unsigned char *data, long size, uint seed)
+{
+    for(long i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+}
+
+static void test_round_trip(uint k, long size)
+{
+    long cover_size = matrix_cover_size(size, k);
+    long groups = (size * 8 + k - 1) / k;
+    unsigned char *data = malloc(size);
+    unsigned char *out = malloc(size);
+    unsigned char *cover = calloc(cover_size + MATRIX_COVER_PADDING, 1);
+    unsigned char *original = malloc(cover_size);
+    long changed = -1;
+    fill(data, size, k);
+    fill(cover, cover_size, 100 + k);
+    memcpy(original, cover, cover_size);
+
+    CHECK(cover_size == groups * ((1L << k) - 1));
+    CHECK(matrix_embed(data, size, k, cover, &changed) == e_success);
+    CHECK(matrix_extract(cover, size, k, out) == e_success);
+    CHECK(memcmp(data, out, size) == 0);
+
+    //only LSBs change, at most one per group
+    long diff = 0;
+    int only_lsb = 1, one_per_group = 1;
+    for(long g = 0; g < groups; g++)
+    {
+        int in_group = 0;
+        for(long i = g * ((1L << k) - 1); i < (g + 1) * ((1L << k) - 1); i++)
+        {
+            in_group += cover[i] != original[i];
+            only_lsb &= (cover[i] ^ original[i]) <= 1;
+        }
+        one_per_group &= in_group <= 1;
+        diff += in_group;
+    }
+    CHECK(only_lsb);
+    CHECK(one_per_group);
+    CHECK(diff == changed);
+    if(groups > 100)
+    {
+        CHECK(changed < groups);   //about (2^k - 1) / 2^k of the groups change for random data
+    }
+    free(data);
+    free(out);
+    free(cover);
+    free(original);
+}
+
+//syndrome of a group is the XOR of the indices of bytes with LSB 1
+static void test_syndrome(void)
+{
+    unsigned char cover[7 + MATRIX_COVER_PADDING] = {0};
+    CHECK(matrix_syndrome(cover, 3) == 0);
+    cover[2] = 1;   //index 3
+    cover[4] = 3;   //index 5
+    CHECK(matrix_syndrome(cover, 3) == (3 ^ 5));
+}
+
+int main(void)
+{
+    test_syndrome();
+    for(uint k = MATRIX_MIN_K; k <= MATRIX_MAX_K; k++)
+    {
+        test_round_trip(k, 1);
+        test_round_trip(k, 1000);
+    }
+    return UNIT_DONE("test_matrix");
+}
@@ -0,0 +1,14 @@
+# CLI tests of matrix embedding (-m)
+source "$(dirname "$0")/lib.sh"
+
+seq 1 600 > big.txt
+for k in 2 4 8; do
+    check "matrix encode k=$k" "Encoding Done Successfully" $STEGO -e $ASSETS/beautiful.bmp big.txt m$k.bmp -m $k
+    check "matrix decode k=$k" "Decoding Done Successfully" $STEGO -d m$k.bmp out$k
+    check_same "matrix round trip k=$k" out$k.txt big.txt
+done
+check "matrix with encryption and RS" "Encoding Done Successfully" $STEGO -e $ASSETS/beautiful.bmp big.txt mkr.bmp -m 3 -k pass -r
+check "decode matrix with encryption and RS" "Decoding Done Successfully" $STEGO -d mkr.bmp mkr -k pass
+check_same "matrix round trip with -k -r" mkr.txt big.txt
+check "k out of range" "-m needs k from 2 to 8" $STEGO -e $ASSETS/beautiful.bmp big.txt bad.bmp -m 9
+finish
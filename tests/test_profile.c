@@ -0,0 +1,87 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Unit tests of profile.c stage bookkeeping, works without
+              hardware counters (they are reported as n/a).
+*/
+
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "profile.h"
+#include "unit.h"
+
+static void sleep_ms(long ms)
+{
+    struct timespec t = {0, ms * 1000000L};
+    nanosleep(&t, NULL);
+}
+
+//stages with the same name add up, NULL ends the current stage
+static void test_stages(void)
+{
+    ProfileInfo prof;
+    profile_stage(NULL, "ignored");   //profiling off
+    CHECK(profile_open(&prof) == e_success);
+    profile_stage(&prof, "a");
+    sleep_ms(2);
+    profile_stage(&prof, "b");
+    profile_stage(&prof, "a");
+    sleep_ms(1);
+    profile_stage(&prof, NULL);
+    sleep_ms(2);   //not in any stage
+
+    CHECK(prof.stage_count == 2);
+    CHECK(prof.current == -1);
+    CHECK(!strcmp(prof.stages[0].name, "a") && !strcmp(prof.stages[1].name, "b"));
+    CHECK(prof.stages[0].ns >= 3e6 && prof.stages[0].ns < 1e9);
+    CHECK(prof.stages[1].ns >= 0 && prof.stages[1].ns < prof.stages[0].ns);
+    profile_close(&prof);
+}
+
+//read / write syscalls of a stage are counted with either syscall source
+static void test_syscalls(void)
+{
+    ProfileInfo prof;
+    profile_open(&prof);
+    int fd = open("/dev/null", O_WRONLY);
+    profile_stage(&prof, "write");
+    for(int i = 0; i < 10; i++)
+    {
+        CHECK(write(fd, "x", 1) == 1);
+    }
+    profile_stage(&prof, NULL);
+    close(fd);
+    if(prof.syscall_source != e_sys_none)
+    {
+        CHECK(prof.stages[0].count[e_prof_syscalls] >= 10);
+    }
+    profile_close(&prof);
+}
+
+//stages past PROFILE_MAX_STAGES are not measured
+static void test_stage_limit(void)
+{
+    static char names[PROFILE_MAX_STAGES + 4][8];
+    ProfileInfo prof;
+    profile_open(&prof);
+    for(int i = 0; i < PROFILE_MAX_STAGES + 4; i++)
+    {
+        snprintf(names[i], sizeof(names[i]), "s%d", i);
+        profile_stage(&prof, names[i]);
+    }
+    profile_stage(&prof, NULL);
+    CHECK(prof.stage_count == PROFILE_MAX_STAGES);
+    profile_close(&prof);
+}
+
+int main(void)
+{
+    test_stages();
+    test_syscalls();
+    test_stage_limit();
+    return UNIT_DONE("test_profile");
+}
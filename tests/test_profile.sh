@@ -0,0 +1,11 @@
+# CLI tests of stage profiling (-p)
+source "$(dirname "$0")/lib.sh"
+
+seq 1 600 > big.txt
+check "profiled encode" "Per payload byte (2292 bytes)" $STEGO -e $ASSETS/beautiful.bmp big.txt p.bmp -p
+check "encode stage table" "file data" $STEGO -e $ASSETS/beautiful.bmp big.txt p2.bmp -p
+$STEGO -e $ASSETS/beautiful.bmp big.txt plain.bmp > /dev/null
+check_same "profiling does not change output" p.bmp plain.bmp
+check "profiled decode" "Per payload byte (2292 bytes)" $STEGO -d p.bmp out -p
+check_same "profiled round trip" out.txt big.txt
+finish
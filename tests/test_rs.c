@@ -0,0 +1,174 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Unit tests of rs.c, round trip of interleaved RS(255,223)
+              codewords, correction of up to 16 byte errors per codeword
+              and rejection of a codeword with more errors, on the byte wise
+              and the SSSE3 region multiply. Tables are built once when
+              several threads encode at the same time.
+*/
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <string.h>
+#include "rs.h"
+#include "unit.h"
+
+//to fill data with a fixed pseudo random sequence
+static void fill(unsigned char *data, uint size, uint seed)
+{
+    for(uint i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+}
+
+//symbol j of codeword c, codewords are interleaved byte wise
+static unsigned char *symbol(unsigned char *encoded, uint size, uint c, uint j)
+{
+    uint blocks = (size + RS_K - 1) / RS_K;
+    return encoded + j * blocks + c;
+}
+
+static void test_round_trip(uint size)
+{
+    unsigned char *data = malloc(size);
+    unsigned char *encoded = malloc(rs_encoded_size(size));
+    int corrected = -1;
+    fill(data, size, size);
+    CHECK(rs_encoded_size(size) == (size + RS_K - 1) / RS_K * RS_N);
+    CHECK(rs_encode(data, size, encoded) == e_success);
+    CHECK(memcmp(encoded, data, size) == 0);   //data part stays in order
+    CHECK(rs_decode(encoded, size, &corrected) == e_success);
+    CHECK(corrected == 0);
+    CHECK(memcmp(encoded, data, size) == 0);
+    free(data);
+    free(encoded);
+}
+
+//16 errors in every codeword, data and parity symbols, are corrected
+static void test_correct_max_errors(void)
+{
+    uint size = 1000, blocks = (size + RS_K - 1) / RS_K;
+    unsigned char *data = malloc(size);
+    unsigned char *encoded = malloc(rs_encoded_size(size));
+    int corrected = 0;
+    fill(data, size, 7);
+    rs_encode(data, size, encoded);
+    for(uint c = 0; c < blocks; c++)
+    {
+        for(uint e = 0; e < RS_PARITY / 2; e++)
+        {
+            *symbol(encoded, size, c, (c * 31 + e * 15) % RS_N) ^= 0x5a + e;
+        }
+    }
+    CHECK(rs_decode(encoded, size, &corrected) == e_success);
+    CHECK(corrected == (int)(blocks * RS_PARITY / 2));
+    CHECK(memcmp(encoded, data, size) == 0);
+    free(data);
+    free(encoded);
+}
+
+//17 errors in one codeword are reported and that codeword is left as it was
+static void test_too_many_errors(void)
+{
+    uint size = 1000;
+    uint encoded_size = rs_encoded_size(size);
+    unsigned char *data = malloc(size);
+    unsigned char *encoded = malloc(encoded_size);
+    unsigned char *damaged = malloc(encoded_size);
+    int corrected = 0;
+    fill(data, size, 11);
+    rs_encode(data, size, encoded);
+    for(uint e = 0; e <= RS_PARITY / 2; e++)
+    {
+        *symbol(encoded, size, 1, 3 + e) ^= 0xa5 + e;   //this pattern gets past the locator degree check to the root search
+    }
+    memcpy(damaged, encoded, encoded_size);
+    CHECK(rs_decode(encoded, size, &corrected) == e_failure);
+    CHECK(memcmp(encoded, damaged, encoded_size) == 0);
+    free(data);
+    free(encoded);
+    free(damaged);
+}
+
+#define INIT_THREADS 8
+#define INIT_SIZE 5000
+
+static unsigned char init_data[INIT_SIZE];
+static unsigned char init_out[INIT_THREADS][(INIT_SIZE + RS_K - 1) / RS_K * RS_N];
+
+static void *encode_thread(void *arg)
+{
+    rs_encode(init_data, INIT_SIZE, init_out[(long)arg]);   //first use builds the tables
+    return NULL;
+}
+
+//threads racing on the first rs_encode get the same parity as a later single thread
+static void test_concurrent_init(void)
+{
+    pthread_t threads[INIT_THREADS];
+    fill(init_data, INIT_SIZE, 3);
+    for(long t = 0; t < INIT_THREADS; t++)
+    {
+        pthread_create(&threads[t], NULL, encode_thread, (void *)t);
+    }
+    for(int t = 0; t < INIT_THREADS; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    unsigned char *expected = malloc(rs_encoded_size(INIT_SIZE));
+    rs_encode(init_data, INIT_SIZE, expected);
+    for(int t = 0; t < INIT_THREADS; t++)
+    {
+        CHECK(memcmp(init_out[t], expected, rs_encoded_size(INIT_SIZE)) == 0);
+    }
+    free(expected);
+}
+
+//SSSE3 and byte wise region multiplies agree, also on lengths with a tail
+static void test_region_paths(void)
+{
+    unsigned char src[64], dst[64], simd[64], scalar[64];
+    fill(src, sizeof(src), 5);
+    fill(dst, sizeof(dst), 6);
+    for(int c = 0; c < 256; c += 17)
+    {
+        for(uint len = 0; len <= sizeof(src); len += 7)
+        {
+            rs_use_simd(1);
+            memcpy(simd, dst, sizeof(dst));
+            gf_region_mul_xor(simd, src, c, len);
+            gf_region_mul(simd, c + 1, len);
+            rs_use_simd(0);
+            memcpy(scalar, dst, sizeof(dst));
+            gf_region_mul_xor(scalar, src, c, len);
+            gf_region_mul(scalar, c + 1, len);
+            CHECK(memcmp(simd, scalar, sizeof(simd)) == 0);
+        }
+    }
+}
+
+int main(void)
+{
+    test_concurrent_init();   //before anything else calls rs_init
+    test_region_paths();
+    for(int simd = 0; simd <= 1; simd++)   //every test runs on the byte wise and the SSSE3 path
+    {
+        if(rs_use_simd(simd) != simd)
+        {
+            printf("test_rs: no SSSE3 on this CPU, byte wise path only\n");
+            continue;
+        }
+        test_round_trip(1);
+        test_round_trip(RS_K);
+        test_round_trip(RS_K + 1);
+        test_round_trip(5000);
+        test_correct_max_errors();
+        test_too_many_errors();
+    }
+    return UNIT_DONE("test_rs");
+}
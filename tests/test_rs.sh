@@ -0,0 +1,20 @@
+# CLI tests of Reed-Solomon protected payload (-r)
+source "$(dirname "$0")/lib.sh"
+
+seq 1 600 > big.txt
+check "RS encode" "Encoding Done Successfully" $STEGO -e $ASSETS/beautiful.bmp big.txt r.bmp -r
+
+#to overwrite 80 pixel bytes inside the payload, about 10 payload bytes
+head -c 80 /dev/zero | tr '\0' '\377' | dd of=r.bmp bs=1 seek=4054 conv=notrunc 2> /dev/null
+check "RS corrects damaged pixels" "Corrected 10 byte errors" $STEGO -d r.bmp out
+check_same "RS round trip" out.txt big.txt
+
+#header fields are not RS protected, flipped LSBs in them must be rejected before use
+#file size field starts at 54 + magic 16 + flags 32 + extension size 32 + ".txt" 32
+cp r.bmp size.bmp
+printf '\001' | dd of=size.bmp bs=1 seek=167 conv=notrunc 2> /dev/null   #bit 30 of file size
+check "damaged file size" "Invalid secret file size" $STEGO -d size.bmp out2
+cp r.bmp extn.bmp
+printf '\001' | dd of=extn.bmp bs=1 seek=102 conv=notrunc 2> /dev/null   #bit 31 of extension size
+check "damaged extension size" "Invalid secret file extension size" $STEGO -d extn.bmp out3
+finish
@@ -0,0 +1,48 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Unit tests of frame geometry parsing in stream.c.
+*/
+
+#include "stream.h"
+#include "unit.h"
+
+static void test_valid_geometry(void)
+{
+    FrameGeometry geo;
+    CHECK(parse_frame_geometry("320x240x3", &geo) == e_success);
+    CHECK(geo.width == 320 && geo.height == 240 && geo.bpp == 3 && geo.header_size == 0);
+    CHECK(geo.pixel_size == 320 * 240 * 3 && geo.frame_size == geo.pixel_size);
+    CHECK(geo.capacity == geo.pixel_size / 8 - STREAM_HEADER_BYTES);
+
+    CHECK(parse_frame_geometry("64x64x4+54", &geo) == e_success);
+    CHECK(geo.header_size == 54 && geo.frame_size == 54 + 64 * 64 * 4);
+}
+
+static void test_invalid_geometry(void)
+{
+    FrameGeometry geo;
+    const char *invalid[] =
+    {
+        "", "320", "320x240", "320x240x", "320x240x3junk", "320x240x3+", "320x240x3+54x",
+        "320x240x3 ", " 320x240x3", "-1x240x3", "320x+240x3", "320x240x0", "320x240x5",
+        "0x240x3", "4294967296x1x1", "65536x65536x4", "8x8x1",
+    };
+    for(unsigned i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        if(parse_frame_geometry(invalid[i], &geo) != e_failure)
+        {
+            printf("accepted \"%s\"\n", invalid[i]);
+            CHECK(0);
+        }
+    }
+}
+
+int main(void)
+{
+    test_valid_geometry();
+    test_invalid_geometry();
+    return UNIT_DONE("test_stream");
+}
@@ -0,0 +1,33 @@
+# CLI tests of frame stream mode
+source "$(dirname "$0")/lib.sh"
+
+G=64x64x3
+FRAME=$((64 * 64 * 3))
+head -c $((FRAME * 12)) $ASSETS/beautiful.bmp > in.raw
+seq 1 1500 > secret.txt
+check "stream encode" "Stream Encoding Done Successfully" $STEGO -fe in.raw secret.txt out.raw -g $G
+CAPACITY=$((FRAME / 8 - 11))   #payload bytes per frame after the sequence header
+payload_frames=$((($(wc -c < secret.txt) + CAPACITY - 1) / CAPACITY))
+check "stream decode" "Stream Decoding Done Successfully" $STEGO -fd out.raw dec.txt -g $G
+check_same "stream round trip" dec.txt secret.txt
+check "stream decode from stdin" "Stream Decoding Done Successfully" sh -c "cat out.raw | $STEGO -fd - dec2.txt -g $G"
+check_same "stdin round trip" dec2.txt secret.txt
+
+#slow producer keeps the pipe open after the last payload frame, so the reader
+#is waiting in poll for the next frame when the decoder is done, it must still finish
+mkfifo pipe
+(for i in $(seq 0 $((payload_frames - 1))); do dd if=out.raw bs=$FRAME skip=$i count=1 2> /dev/null; sleep 0.2; done; sleep 20) > pipe &
+producer=$!
+check "decode with open pipe" "Stream Decoding Done Successfully" timeout 10 $STEGO -fd pipe dec3.txt -g $G
+kill $producer 2> /dev/null
+check_same "open pipe round trip" dec3.txt secret.txt
+
+head -c $((FRAME * 2)) out.raw > short.raw
+check "stream ends before last frame" "before the last payload frame" $STEGO -fd short.raw d4.txt -g $G
+{ head -c $FRAME out.raw; tail -c +$((FRAME * 2 + 1)) out.raw; } > dropped.raw
+head -c $((FRAME + 100)) out.raw > partial.raw
+check "partial frame" "partial frame of 100 bytes" $STEGO -fe partial.raw secret.txt o2.raw -g $G
+check "dropped frame" "Expected frame 1, got frame 2" $STEGO -fd dropped.raw d5.txt -g $G
+check "secret longer than stream" "were embedded" $STEGO -fe short.raw secret.txt o.raw -g $G
+check "geometry with trailing junk" "Invalid frame geometry" $STEGO -fd out.raw d6.txt -g ${G}junk
+finish
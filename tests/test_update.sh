@@ -0,0 +1,30 @@
+# CLI tests of incremental update (-u) of chunked stego images
+source "$(dirname "$0")/lib.sh"
+
+seq 1 600 > v1.txt
+check "chunked encode" "Encoding Done Successfully" $STEGO -e $ASSETS/beautiful.bmp v1.txt c.bmp -c 64
+#chunk digests and header fields must change only the LSB of cover bytes
+check "only LSBs changed" "only LSBs differ" perl -e 'local $/; open A, $ARGV[0]; open B, $ARGV[1]; my $x = <A> ^ <B>; print $x =~ /[^\0\1]/ ? "other bits differ\n" : "only LSBs differ\n"' $ASSETS/beautiful.bmp c.bmp
+check "unchanged update" "Rewrote 0 of" $STEGO -u c.bmp v1.txt
+
+sed 's/^300$/3OO/' v1.txt > v2.txt
+check "one changed chunk" "Rewrote 1 of" $STEGO -u c.bmp v2.txt
+check "decode after update" "Decoding Done Successfully" $STEGO -d c.bmp out
+check_same "update round trip" out.txt v2.txt
+
+#two 64 byte chunks with the same FNV-1a 32 bit hash get different digests
+printf 'update test chunk, the last line differs in eight chars:rihdkgod' > a.txt
+printf 'update test chunk, the last line differs in eight chars:kqbqjpvg' > b.txt
+check "collision encode" "Encoding Done Successfully" $STEGO -e $ASSETS/beautiful.bmp a.txt h.bmp -c 64
+check "colliding chunk is rewritten" "Rewrote 1 of 1 chunks" $STEGO -u h.bmp b.txt
+$STEGO -d h.bmp hout > /dev/null
+check_same "colliding chunk round trip" hout.txt b.txt
+
+seq 1 2000 > long.txt
+cp v1.txt v1.c
+check "secret larger than reserved" "bytes were reserved" $STEGO -u c.bmp long.txt
+check "other extension" "Stego image holds a .txt file, new secret is .c" $STEGO -u c.bmp v1.c
+$STEGO -e $ASSETS/beautiful.bmp v1.txt plain.bmp > /dev/null
+check "not chunked" "is not chunked" $STEGO -u plain.bmp v1.txt
+check "extra argument" "-u needs <stego image> <new secret file>" $STEGO -u c.bmp v1.txt extra
+finish
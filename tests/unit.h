@@ -0,0 +1,22 @@
+#ifndef UNIT_H
+#define UNIT_H
+
+#include <stdio.h>
+
+/* Minimal checks for unit tests, a failed check is printed and counted */
+static int unit_checks;
+static int unit_failures;
+
+#define CHECK(cond) do { \
+        unit_checks++; \
+        if(!(cond)) \
+        { \
+            unit_failures++; \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while(0)
+
+/* Print summary, value for return of main */
+#define UNIT_DONE(name) (printf("%s: %d checks, %d failed\n", name, unit_checks, unit_failures), unit_failures != 0)
+
+#endif
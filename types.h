@@ -15,7 +15,32 @@ typedef enum
 {
     e_encode,
     e_decode,
+    e_batch,
+    e_daemon,
+    e_update,
+    e_stream_encode,
+    e_stream_decode,
+    e_analyze,
+    e_coordinator,
+    e_worker,
     e_unsupported
 } OperationType;
 
+/* Optional command line settings, common for encoding and decoding */
+typedef struct _StegoOptions
+{
+    char *password;   //-k <password>, encrypt / decrypt secret data
+    int ecc;         //-r, add Reed-Solomon error correction while encoding
+    uint queue_depth;   //-q <n>, batch mode I/O requests in flight, 0 for default
+    uint buffers;      //-n <n>, batch mode image buffers, 0 for default
+    uint threads;     //-t <n>, daemon / analysis worker threads, 0 for default
+    char *socket_path;   //-s <socket>, send -e / -d request to daemon
+    uint chunk_size;    //-c <bytes>, chunked payload with digests for -u update, 0 if not chunked
+    char *geometry;    //-g <width>x<height>x<bpp>[+<header>], frame stream geometry
+    uint lease_seconds;   //-l <seconds>, coordinator job lease, 0 for default
+    uint matrix_k;       //-m <k>, Hamming matrix embedding of secret data, 0 for plain LSB
+    int profile;        //-p, report performance counters of -e / -d stages
+
+} StegoOptions;
+
 #endif
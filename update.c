@@ -0,0 +1,295 @@
+/*
+Name        : Binil George
+Date        : 17-11-2025
+Project     : LSB Image Steganography (Encoding & Decoding)
+
+Description : Incremental update of a chunked stego image (encoded with -c).
+
+              The stego header of a chunked image holds a digest of every
+              payload chunk (SHA-256 truncated to 128 bit). -u compares the
+              new secret file against these digests and rewrites in place
+              only the image bytes of chunks which changed. The digest table
+              and file size are written last as the header commit, so an
+              interrupted update is repaired by running -u again.
+
+              An unchanged chunk costs one read of its digest, the embedded
+              data is never read back. Writes are proportional to the size
+              of the change.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "update.h"
+#include "cipher.h"
+#include "encode.h"
+#include "decode.h"
+#include "format.h"
+#include "common.h"
+#include "types.h"
+
+void chunk_digest(const char *data, uint len, unsigned char *digest)
+{
+    unsigned char full[32];
+    cipher_sha256((const unsigned char *)data, len, full);
+    memcpy(digest, full, CHUNK_DIGEST_SIZE);
+}
+
+//to rewrite the unsigned int stored in 32 image bytes at offset
+static Status write_uint_at(FILE *fptr, long offset, uint value)
+{
+    char buffer[32];
+    if(fseek(fptr, offset, SEEK_SET) != 0 || fread(buffer, 1, 32, fptr) != 32)
+    {
+        printf("Error while reading\n");
+        return e_failure;
+    }
+    encode_uint_to_lsb(value, buffer);
+    if(fseek(fptr, offset, SEEK_SET) != 0 || fwrite(buffer, 1, 32, fptr) != 32)
+    {
+        printf("Error while writing\n");
+        return e_failure;
+    }
+    return e_success;
+}
+
+//to read the chunk digest stored in image bytes at offset
+static Status read_digest_at(FILE *fptr, long offset, unsigned char *digest)
+{
+    char buffer[CHUNK_DIGEST_SIZE * 8];
+    if(fseek(fptr, offset, SEEK_SET) != 0 || fread(buffer, 1, sizeof(buffer), fptr) != sizeof(buffer))
+    {
+        printf("Error while reading\n");
+        return e_failure;
+    }
+    for(int i = 0; i < CHUNK_DIGEST_SIZE; i++)
+    {
+        digest[i] = decode_byte_from_lsb(buffer + 8 * i);
+    }
+    return e_success;
+}
+
+//to rewrite the chunk digest stored in image bytes at offset
+static Status write_digest_at(FILE *fptr, long offset, const unsigned char *digest)
+{
+    char buffer[CHUNK_DIGEST_SIZE * 8];
+    if(fseek(fptr, offset, SEEK_SET) != 0 || fread(buffer, 1, sizeof(buffer), fptr) != sizeof(buffer))
+    {
+        printf("Error while reading\n");
+        return e_failure;
+    }
+    for(int i = 0; i < CHUNK_DIGEST_SIZE; i++)
+    {
+        encode_byte_to_lsb(digest[i], buffer + 8 * i);
+    }
+    if(fseek(fptr, offset, SEEK_SET) != 0 || fwrite(buffer, 1, sizeof(buffer), fptr) != sizeof(buffer))
+    {
+        printf("Error while writing\n");
+        return e_failure;
+    }
+    return e_success;
+}
+
+//to re-embed len bytes of data at payload offset start
+static Status rewrite_chunk(FILE *fptr, long data_offset, const char *data, uint start, uint len)
+{
+    if(len == 0)   //chunk past end of new secret, only its digest changes
+    {
+        return e_success;
+    }
+    char *buffer = malloc(len * 8);
+    long offset = data_offset + (long)start * 8;
+    if(buffer == NULL || fseek(fptr, offset, SEEK_SET) != 0 || fread(buffer, 1, len * 8, fptr) != len * 8)
+    {
+        printf("Error while reading chunk data\n");
+        free(buffer);
+        return e_failure;
+    }
+    for(uint i = 0; i < len; i++)
+    {
+        encode_byte_to_lsb(data[start + i], buffer + 8 * i);
+    }
+    Status status = e_success;
+    if(fseek(fptr, offset, SEEK_SET) != 0 || fwrite(buffer, 1, len * 8, fptr) != len * 8)
+    {
+        printf("Error while writing chunk data\n");
+        status = e_failure;
+    }
+    free(buffer);
+    return status;
+}
+
+//to parse stego header up to secret data, checks secret extension is unchanged
+static Status update_read_header(DecodeInfo *decInfo, const char *extn, long *size_offset, long *data_offset)
+{
+    if(skip_image_header(decInfo) == e_failure || decode_magic_string(decInfo) == e_failure || decode_stego_flags(decInfo) == e_failure)
+    {
+        printf("ERROR: %s is not a stego image\n", decInfo->stego_image_fname);
+        return e_failure;
+    }
+    if(!(decInfo->flags & STEGO_FLAG_CHUNKED))
+    {
+        printf("ERROR: %s is not chunked, encode it with -c <chunk size> to allow updates\n", decInfo->stego_image_fname);
+        return e_failure;
+    }
+    if(decode_secret_file_extn_size(decInfo) == e_failure)
+    {
+        return e_failure;
+    }
+
+    //extension is decoded here, decode_secret_file_extn would open an output file
+    char stored_extn[sizeof(decInfo->secret_extn)] = {0};
+    char buffer[8];
+    for(int i = 0; i < decInfo->secret_extn_size; i++)
+    {
+        if(fread(buffer, 1, 8, decInfo->fptr_stego_image) != 8)
+        {
+            printf("Error while reading\n");
+            return e_failure;
+        }
+        stored_extn[i] = decode_byte_from_lsb(buffer);
+    }
+    if(strcmp(stored_extn, extn))
+    {
+        printf("ERROR: Stego image holds a %s file, new secret is %s\n", stored_extn, extn);
+        return e_failure;
+    }
+
+    *size_offset = ftell(decInfo->fptr_stego_image);
+    if(decode_secret_file_size(decInfo) == e_failure)
+    {
+        return e_failure;
+    }
+    *data_offset = ftell(decInfo->fptr_stego_image);
+    return e_success;
+}
+
+/*
+ * Update chunked stego image in place
+ * Input: argv[2] stego image, argv[3] new secret file
+ * Description: only chunks whose digest differs are re-embedded,
+ * then changed digests and the file size are committed.
+ */
+Status do_update(char *argv[], int argc, const StegoOptions *opts)
+{
+    if(argc != 4)
+    {
+        printf("ERROR: -u needs <stego image> <new secret file>\n");
+        return e_failure;
+    }
+    const char *extn = strrchr(argv[3], '.');
+    if(format_from_fname(argv[2]) == NULL)
+    {
+        printf("%s is not a %s file\n", argv[2], SUPPORTED_IMAGE_EXTNS);
+        return e_failure;
+    }
+    if(extn == NULL)
+    {
+        printf("%s has no file extension\n", argv[3]);
+        return e_failure;
+    }
+
+    printf("INFO: ## Update Procedure Started ##\n");
+    DecodeInfo decInfo;
+    memset(&decInfo, 0, sizeof(decInfo));
+    decInfo.stego_image_fname = argv[2];
+    decInfo.password = opts->password;
+    decInfo.fptr_stego_image = fopen(argv[2], "r+");
+    FILE *fptr_secret = fopen(argv[3], "r");
+    if(decInfo.fptr_stego_image == NULL || fptr_secret == NULL)
+    {
+        perror("fopen");
+        fprintf(stderr, "ERROR: Unable to open %s or %s\n", argv[2], argv[3]);
+        if(decInfo.fptr_stego_image != NULL)
+        {
+            fclose(decInfo.fptr_stego_image);
+        }
+        if(fptr_secret != NULL)
+        {
+            fclose(fptr_secret);
+        }
+        return e_failure;
+    }
+
+    Status status = e_failure;
+    long size_offset, data_offset;
+    uint secret_size = get_file_size(fptr_secret);
+    char *secret = malloc(secret_size + 1);
+    unsigned char *new_digests = NULL;   //digest of each chunk of new secret
+    char *dirty = NULL;                 //1 if chunk digest has to be committed
+    if(secret == NULL || fread(secret, 1, secret_size, fptr_secret) != secret_size)
+    {
+        printf("Error while reading secret file data\n");
+    }
+    else if(update_read_header(&decInfo, extn, &size_offset, &data_offset) == e_success)
+    {
+        uint chunk_size = decInfo.chunk_size;
+        uint chunk_count = decInfo.chunk_count;
+        new_digests = malloc((size_t)CHUNK_DIGEST_SIZE * chunk_count);
+        dirty = calloc(chunk_count, 1);
+        if(new_digests == NULL || dirty == NULL)
+        {
+            printf("ERROR: Unable to allocate memory for chunk digests\n");
+        }
+        else if(secret_size > chunk_size * chunk_count)
+        {
+            printf("ERROR: %s needs %u bytes, only %u bytes were reserved, encode the image again\n", argv[3], secret_size, chunk_size * chunk_count);
+        }
+        else
+        {
+            printf("INFO: Comparing %u Chunks of %u bytes\n", chunk_count, chunk_size);
+            uint changed = 0;
+            status = e_success;
+            for(uint i = 0; i < chunk_count && status == e_success; i++)
+            {
+                uint start = i * chunk_size;
+                uint len = (secret_size > start) ? secret_size - start : 0;
+                if(len > chunk_size)
+                {
+                    len = chunk_size;
+                }
+                unsigned char stored_digest[CHUNK_DIGEST_SIZE];
+                unsigned char *new_digest = new_digests + (size_t)CHUNK_DIGEST_SIZE * i;
+                chunk_digest(secret + start, len, new_digest);
+                status = read_digest_at(decInfo.fptr_stego_image, decInfo.chunk_table_offset + CHUNK_DIGEST_SIZE * 8L * i, stored_digest);
+                if(status == e_success && memcmp(stored_digest, new_digest, CHUNK_DIGEST_SIZE))
+                {
+                    status = rewrite_chunk(decInfo.fptr_stego_image, data_offset, secret, start, len);
+                    dirty[i] = 1;
+                    changed++;
+                }
+            }
+
+            //header commit, written after all chunk data
+            for(uint i = 0; i < chunk_count && status == e_success; i++)
+            {
+                if(dirty[i])
+                {
+                    status = write_digest_at(decInfo.fptr_stego_image, decInfo.chunk_table_offset + CHUNK_DIGEST_SIZE * 8L * i, new_digests + (size_t)CHUNK_DIGEST_SIZE * i);
+                }
+            }
+            if(status == e_success && (uint)decInfo.secret_file_size != secret_size)
+            {
+                status = write_uint_at(decInfo.fptr_stego_image, size_offset, secret_size);
+            }
+            if(status == e_success && (fflush(decInfo.fptr_stego_image) != 0 || fsync(fileno(decInfo.fptr_stego_image)) != 0))
+            {
+                perror("fsync");
+                status = e_failure;
+            }
+            if(status == e_success)
+            {
+                printf("INFO: Rewrote %u of %u chunks\n", changed, chunk_count);
+                printf("INFO: ## Update Done Successfully ##\n");
+            }
+        }
+    }
+
+    free(secret);
+    free(new_digests);
+    free(dirty);
+    fclose(fptr_secret);
+    fclose(decInfo.fptr_stego_image);
+    return status;
+}
@@ -0,0 +1,15 @@
+#ifndef UPDATE_H
+#define UPDATE_H
+
+#include "types.h" // Contains user defined types
+
+/* Size of the digest stored per payload chunk, SHA-256 truncated to 128 bit */
+#define CHUNK_DIGEST_SIZE 16
+
+/* Digest of one payload chunk */
+void chunk_digest(const char *data, uint len, unsigned char *digest);
+
+/* Re-embed changed chunks of new secret into chunked stego image in place */
+Status do_update(char *argv[], int argc, const StegoOptions *opts);
+
+#endif